@@ -1,6 +1,8 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "base.h"
 
@@ -14,9 +16,9 @@ uint8_t officialHeader[26];
 uint16_t vectors[3]; // HW vector addresses in CPU memory
 int absVectors[3];   // HW vector addresses in ROM
 
-uint8_t uniqueTilesBuf[256][16];
 int *uniqueTileCounter;
 int *emptySpacePrg;
+uint8_t *prgRom; // Whole PRG-ROM, loaded on demand by loadPrgRom()
 
 int64_t prgSize;
 int64_t chrSize;
@@ -27,6 +29,84 @@ int isNes2;
 int hasOfficialHeader;
 char gameTitle[16];
 
+// Decode the sizes and mapper of an iNES/NES 2.0 header, without touching the globals
+void decodeINesHeader(const uint8_t *header, RomLayout *out){
+	out->isNes2 = ((header[7]&0x0c) == 0x08);
+	out->mapper = (header[6]>>4) | (header[7]&0xf0) | (out->isNes2 ? (header[8]&0xf)<<8 : 0);
+	out->hasTrainer = (header[6]&0x04);
+
+	if(!out->isNes2){
+		out->prgSize = header[4];
+		out->chrSize = header[5];
+		return;
+	}
+
+	uint8_t prgSizeExtra = header[9]&0x0f;
+	uint8_t chrSizeExtra = header[9]>>4;
+
+	if(prgSizeExtra != 0x0f)
+		out->prgSize = header[4] | prgSizeExtra<<8;
+	else{
+		// Use exponent multiplier notation
+		int exponent = header[4]>>2;
+		int multiplier = header[4]&0x03;
+
+		// PRG size = 2^exponent * (multiplier * 2 + 1) bytes
+		// NOTE: The conversion to 16 KiB banks may not be exact
+		out->prgSize = ((int64_t)0x01<<exponent) * (multiplier*2 + 1) / (16*1024);
+	}
+
+	if(chrSizeExtra != 0x0f)
+		out->chrSize = header[5] | chrSizeExtra<<8;
+	else{
+		int exponent = header[5]>>2;
+		int multiplier = header[5]&0x03;
+
+		out->chrSize = ((int64_t)0x01<<exponent) * (multiplier*2 + 1) / (8*1024);
+	}
+}
+
+void readINesHeader(FILE *rom){
+	RomLayout layout;
+
+	fread(iNesHeader, 16, 1, rom);
+	if(memcmp(iNesHeader, "NES\x1a", 4)){
+		fprintf(stderr, "This file isn't an NES ROM.\n");
+		exit(1);
+	}
+	decodeINesHeader(iNesHeader, &layout);
+	isNes2 = layout.isNes2;
+	mapper = layout.mapper;
+	hasTrainer = layout.hasTrainer;
+	prgSize = layout.prgSize;
+	chrSize = layout.chrSize;
+}
+
+// Check the fields of an official header that are reliable enough to detect it
+uint8_t isOfficialHeader(const uint8_t *header){
+	return
+		header[22] && header[22] < 3 &&
+		header[23] && header[23] < 16;
+}
+
+void readOfficialHeader(FILE *rom){
+	fseek(rom, 16+hasTrainer*512+16*1024*prgSize-32, SEEK_SET);
+	fread(officialHeader, 26, 1, rom);
+	hasOfficialHeader = isOfficialHeader(officialHeader);
+
+	if(!(hasOfficialHeader)) return;
+	memcpy(gameTitle, &officialHeader[15-officialHeader[23]], officialHeader[23]+1);
+}
+
+void readHwVectors(FILE *rom){
+	fseek(rom, 16+hasTrainer*512+16*1024*prgSize-6, SEEK_SET);
+	fread(vectors, 2, 3, rom);
+
+	for(int i=0;i<3;i++){
+		absVectors[i] = getLastBankOffset(vectors[i]);
+	}
+}
+
 // Return the file offset of the given CPU address, mapped to the two last PRG banks
 // This uses a heuristic that assumes the full PRG is visible for NROM (16 or 32 KiB) ROMs,
 //  or that the last bank is fixed at 0xC000-0xFFFF (MMC style).
@@ -41,6 +121,29 @@ uint32_t getLastBankOffset(uint16_t addr) {
 	return bankStart + offsetInBank;
 }
 
+// Return the PRG-ROM offset of a CPU address, or -1 if it isn't in ROM
+int32_t prgOffset(uint16_t addr){
+	if(addr < 0x8000 || !prgSize) return -1;
+	int32_t offset = getLastBankOffset(addr) - 16 - hasTrainer*512;
+	if(offset < 0 || offset >= prgSize*16*1024) return -1;
+	return offset;
+}
+
+// Inverse of prgOffset(): return the CPU address of a PRG-ROM offset, or -1 if the
+//  offset is in a bank that isn't visible in the fixed-bank view
+int32_t cpuAddress(uint32_t offset){
+	uint32_t bank = offset / (16*1024);
+	if(bank == prgSize-1) return 0xC000 | (offset&0x3FFF);
+	if(prgSize >= 2 && bank == prgSize-2) return 0x8000 | (offset&0x3FFF);
+	return -1;
+}
+
+// Read a byte of the loaded PRG-ROM through the fixed-bank mapping; 0 if unmapped
+uint8_t peekPrg(uint16_t addr){
+	int32_t offset = prgOffset(addr);
+	return offset < 0 ? 0 : prgRom[offset];
+}
+
 int16_t readMemory(FILE* fp, uint16_t addr){
 	uint32_t offset = getLastBankOffset(addr);
 
@@ -48,4 +151,19 @@ int16_t readMemory(FILE* fp, uint16_t addr){
 
 	// May return EOF
 	return fgetc(fp);
-}
\ No newline at end of file
+}
+
+// Read the whole PRG-ROM into prgRom; return nonzero on failure
+uint8_t loadPrgRom(FILE *fp){
+	if(prgRom) return 0;
+	prgRom = malloc(prgSize*16*1024);
+	if(!prgRom) return 1;
+
+	fseek(fp, 16 + hasTrainer*512, SEEK_SET);
+	if(prgSize && !fread(prgRom, prgSize*16*1024, 1, fp)){
+		free(prgRom);
+		prgRom = NULL;
+		return 1;
+	}
+	return 0;
+}
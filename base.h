@@ -4,13 +4,21 @@
 #include <stdint.h>
 #include <stdio.h>
 
+typedef struct{
+	int64_t prgSize; // 16 KiB units
+	int64_t chrSize; // 8 KiB units
+	int     mapper;
+	int     hasTrainer;
+	int     isNes2;
+} RomLayout;
+
 extern uint8_t iNesHeader[16];
 extern uint8_t officialHeader[26];
 extern uint16_t vectors[3];
 extern int absVectors[3];
-extern uint8_t uniqueTilesBuf[256][16];
 extern int *uniqueTileCounter;
 extern int *emptySpacePrg;
+extern uint8_t *prgRom;
 extern int64_t prgSize;
 extern int64_t chrSize;
 extern int mapper;
@@ -19,7 +27,16 @@ extern int isNes2;
 extern int hasOfficialHeader;
 extern char gameTitle[16];
 
+void decodeINesHeader(const uint8_t *header, RomLayout *out);
+void readINesHeader(FILE *rom);
+uint8_t isOfficialHeader(const uint8_t *header);
+void readOfficialHeader(FILE *rom);
+void readHwVectors(FILE *rom);
 uint32_t getLastBankOffset(uint16_t addr);
+int32_t prgOffset(uint16_t addr);
+int32_t cpuAddress(uint32_t offset);
+uint8_t peekPrg(uint16_t addr);
 int16_t readMemory(FILE* fp, uint16_t addr);
+uint8_t loadPrgRom(FILE *fp);
 
 #endif
\ No newline at end of file
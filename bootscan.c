@@ -0,0 +1,146 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "bootscan.h"
+#include "instructions.h"
+
+// Mappers like AxROM, GxROM or most multicarts may power on in any bank, so every
+//  16 KiB bank's last 6 bytes are read as the vectors of a window ending there: the
+//  bank alone at $C000, or with the bank before it for a 32 KiB window at $8000.
+// Only the 6 vector bytes and a few bytes at each plausible reset target are read.
+
+#define INIT_BYTES 32 // Read at each reset target
+#define INIT_INSTRUCTIONS 12
+
+// Score the start of a reset handler, 0-90: games almost always begin with
+//  SEI / CLD / LDX #$FF / TXS and soon touch PPUCTRL/PPUMASK
+static int scoreInitCode(const uint8_t *code, int len){
+	int score = 0, ppu = 0;
+	for(int i=0, pos=0; i<INIT_INSTRUCTIONS && pos < len; i++){
+		Opcode op = opcodes[code[pos]];
+		int opLen = instruction_length[op.addr_mode];
+		if(pos+opLen > len) break;
+
+		// Filler or garbage this early rules the candidate out
+		if(op.instr == INS_INV || op.instr == INS_BRK) return i < 4 ? 0 : score;
+		if(op.instr == INS_SEI && i < 3) score += 30;
+		if(op.instr == INS_CLD && i < 4) score += 25;
+		if(op.instr == INS_LDX && op.addr_mode == AM_IMMEDIATE && code[pos+1] == 0xff && pos+2 < len && code[pos+2] == 0x9a)
+			score += 25;
+		if(op.addr_mode == AM_ABSOLUTE && !ppu && (op.instr == INS_STA || op.instr == INS_STX || op.instr == INS_STY)){
+			uint16_t addr = code[pos+1] | code[pos+2]<<8;
+			if(addr == 0x2000 || addr == 0x2001){
+				score += 10;
+				ppu = 1;
+			}
+		}
+		if(op.instr == INS_JMP || op.instr == INS_RTS || op.instr == INS_RTI) break;
+		pos += opLen;
+	}
+	return score;
+}
+
+static int plausibleHandler(uint16_t addr){
+	return addr >= 0x8000 && addr != 0xffff;
+}
+
+// Read the code at a PRG-ROM offset and score it as a reset handler
+static int scoreTarget(FILE *rom, uint32_t offset){
+	uint8_t code[INIT_BYTES];
+	uint32_t end = prgSize*16*1024;
+	int len = offset+INIT_BYTES <= end ? INIT_BYTES : (int)(end-offset);
+	if(offset >= end) return 0;
+
+	fseek(rom, 16 + hasTrainer*512 + offset, SEEK_SET);
+	if(fread(code, len, 1, rom) != 1) return 0;
+	return scoreInitCode(code, len);
+}
+
+// Collect every bank whose vectors pass the prefilter; return the count or -1 on error
+int scanBootVectors(FILE *rom, BootCandidate **out){
+	BootCandidate *list = malloc((prgSize+1)*sizeof(BootCandidate));
+	int count = 0;
+	if(!list) return -1;
+
+	for(int b=0;b<prgSize;b++){
+		uint8_t raw[6];
+		fseek(rom, 16 + hasTrainer*512 + (int64_t)(b+1)*16*1024 - 6, SEEK_SET);
+		if(fread(raw, 6, 1, rom) != 1) break;
+
+		// Prefilter: a reset vector into ROM that isn't filler
+		uint16_t reset = raw[2] | raw[3]<<8;
+		if(!plausibleHandler(reset) || !memcmp(raw, raw+1, 5)) continue;
+
+		BootCandidate *c = &list[count];
+		c->bank = b;
+		for(int i=0;i<3;i++) c->vectors[i] = raw[i*2] | raw[i*2+1]<<8;
+
+		// The bank alone at $C000 (mirrored at $8000 if it's the only one)...
+		c->window = 16;
+		c->score = 0;
+		if(reset >= 0xc000 || prgSize == 1) c->score = scoreTarget(rom, b*16*1024 + (reset&0x3fff));
+		// ...or a 32 KiB window made with the bank before it
+		if(b&1){
+			int score = scoreTarget(rom, (b-1)*16*1024 + (reset-0x8000));
+			if(score > c->score){
+				c->score = score;
+				c->window = 32;
+			}
+		}
+		if(!c->score) continue;
+		c->score += plausibleHandler(c->vectors[0])*5 + plausibleHandler(c->vectors[2])*5;
+		count++;
+	}
+
+	*out = list;
+	return count;
+}
+
+void printBootScan(FILE *rom){
+	BootCandidate *list;
+	int count = scanBootVectors(rom, &list);
+
+	printf("Reset vector scan:\n");
+	if(count < 0){
+		printf(" Reset vector scan failed: memory error.\n\n");
+		return;
+	}
+	if(!count){
+		printf(" No bank ends with plausible vectors.\n\n");
+		free(list);
+		return;
+	}
+
+	printf(" Bank  Window  NMI    Reset  IRQ    Score\n");
+	int best = 0;
+	for(int i=0;i<count;i++){
+		BootCandidate *c = &list[i];
+		printf(
+			" %-4d  %2d KiB  $%04x  $%04x  $%04x  %d\n",
+			c->bank, c->window, c->vectors[0], c->vectors[1], c->vectors[2], c->score
+		);
+		// Ties go to the later bank, where most mappers boot
+		if(c->score >= list[best].score) best = i;
+	}
+
+	BootCandidate *boot = &list[best];
+	BootCandidate *last = list[count-1].bank == prgSize-1 ? &list[count-1] : NULL;
+	int same = 0;
+	for(int i=0;i<count;i++) same += !memcmp(list[i].vectors, boot->vectors, sizeof(boot->vectors));
+
+	printf("\n Likely boot bank: %d (%d KiB window, reset at $%04x)\n", boot->bank, boot->window, boot->vectors[1]);
+	if(same > 1) printf(" The same vectors end %d banks: a reset stub repeated for a mapper without a fixed bank\n", same);
+	if(!last || memcmp(boot->vectors, last->vectors, sizeof(boot->vectors)))
+		printf(" Warning: the last bank's vectors (used by the other analyses) differ from the boot bank's\n");
+	printf("\n");
+	free(list);
+}
@@ -0,0 +1,23 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_BOOTSCAN_H
+#define FC_BOOTSCAN_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct{
+	int      bank;       // 16 KiB PRG-ROM bank whose last 6 bytes hold the vectors
+	uint16_t vectors[3]; // NMI, reset, IRQ
+	int      window;     // 16 or 32 (KiB) mapped at the top of CPU memory
+	int      score;      // 0-100
+} BootCandidate;
+
+int scanBootVectors(FILE *rom, BootCandidate **out);
+void printBootScan(FILE *rom);
+
+#endif
@@ -0,0 +1,387 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "budget.h"
+#include "instructions.h"
+
+// Worst/best case cycle counts over the control-flow graph of a routine.
+// Loops are handled by folding back edges into their branch: counted loops of the
+//  form LDX/LDY #n ... DEX/DEY, BNE are multiplied out, anything else is counted once.
+
+#define MAX_NODES   2048
+#define MAX_DEPTH   8
+#define MAX_MEMO    256
+#define NMI_ENTRY   7 // Interrupt sequence
+
+enum _exit_kinds{
+	EXIT_NONE,
+	EXIT_RETURN,    // RTS/RTI
+	EXIT_UNRESOLVED // Indirect jump, BRK, invalid opcode or code outside of ROM
+};
+
+typedef struct{
+	uint16_t addr;
+	Opcode   op;
+	int      succ[2];   // Fall-through (or jump target), branch target
+	int      takenCost; // Extra cycles when the branch is taken
+	int      costMin, costMax;
+	uint8_t  exit;
+} Node;
+
+typedef struct{
+	int     best, worst;
+	int     loops;      // Loops with an unknown iteration count
+	uint8_t unresolved;
+} Result;
+
+typedef struct{
+	Node  nodes[MAX_NODES];
+	int   count;
+	int   order[MAX_NODES]; // Topological order, ignoring back edges
+	int   distMin[MAX_NODES], distMax[MAX_NODES];
+	int   predMax[MAX_NODES];
+	int   loops;
+	uint8_t unresolved;
+} Graph;
+
+static struct{
+	uint16_t addr;
+	Result   res;
+} memo[MAX_MEMO];
+static int memoCount;
+
+static Result analyze(uint16_t entry, int depth, Graph **out);
+
+static int findNode(Graph *g, uint16_t addr){
+	for(int i=0;i<g->count;i++){
+		if(g->nodes[i].addr == addr) return i;
+	}
+	return -1;
+}
+
+// Decode the routine at entry into g->nodes, following branches and jumps
+static void buildGraph(Graph *g, uint16_t entry, int depth){
+	// Each node pops one entry and pushes at most two, so the stack never holds more
+	//  than one entry past the node count
+	uint16_t work[MAX_NODES+1];
+	int wp = 0;
+	work[wp++] = entry;
+
+	while(wp){
+		uint16_t addr = work[--wp];
+		if(findNode(g, addr) >= 0 || g->count >= MAX_NODES) continue;
+
+		Node *n = &g->nodes[g->count++];
+		memset(n, 0, sizeof(Node));
+		n->addr = addr;
+		n->succ[0] = n->succ[1] = -1;
+
+		if(prgOffset(addr) < 0){
+			n->exit = EXIT_UNRESOLVED;
+			continue;
+		}
+		n->op = opcodes[peekPrg(addr)];
+		n->costMin = n->op.cycles;
+		n->costMax = n->op.cycles + n->op.page_cross;
+
+		uint16_t next = addr + instruction_length[n->op.addr_mode];
+		uint16_t param16 = peekPrg(addr+1) | peekPrg(addr+2)<<8;
+
+		switch(n->op.instr){
+			case INS_INV:
+			case INS_BRK:
+			n->exit = EXIT_UNRESOLVED;
+			continue;
+
+			case INS_RTS:
+			case INS_RTI:
+			n->exit = EXIT_RETURN;
+			continue;
+
+			case INS_JMP:
+			if(n->op.addr_mode == AM_ABSOLUTE_INDIRECT){
+				n->exit = EXIT_UNRESOLVED;
+				continue;
+			}
+			work[wp++] = param16;
+			continue;
+
+			case INS_JSR:{
+				Result sub = analyze(param16, depth+1, NULL);
+				n->costMin += sub.best;
+				n->costMax += sub.worst;
+				g->loops += sub.loops;
+				g->unresolved |= sub.unresolved;
+				break;
+			}
+
+			case INS_STA:
+			case INS_STX:
+			case INS_STY:
+			if(n->op.addr_mode == AM_ABSOLUTE && param16 == 0x4014){
+				n->costMin += OAM_DMA_CYCLES;
+				n->costMax += OAM_DMA_CYCLES + 1;
+			}
+			break;
+
+			default:;
+		}
+
+		if(n->op.addr_mode == AM_RELATIVE){
+			uint16_t target = relative_addr(next, (int8_t)peekPrg(addr+1));
+			n->takenCost = BRANCH_TAKEN_CYCLES + page_crossed(next, target);
+			work[wp++] = target;
+		}
+		work[wp++] = next;
+	}
+
+	// Resolve successor indices now that every node exists
+	for(int i=0;i<g->count;i++){
+		Node *n = &g->nodes[i];
+		if(n->exit) continue;
+		uint16_t next = n->addr + instruction_length[n->op.addr_mode];
+		if(n->op.instr == INS_JMP){
+			n->succ[0] = findNode(g, peekPrg(n->addr+1) | peekPrg(n->addr+2)<<8);
+		} else{
+			n->succ[0] = findNode(g, next);
+			if(n->op.addr_mode == AM_RELATIVE)
+				n->succ[1] = findNode(g, relative_addr(next, (int8_t)peekPrg(n->addr+1)));
+		}
+	}
+}
+
+// Return the iteration count of a counted loop, or 0 if unknown
+static int loopCount(Graph *g, Node *branch, Node *head){
+	if(branch->op.instr != INS_BNE) return 0;
+
+	int32_t dec = findNode(g, branch->addr-1);
+	if(dec < 0) return 0;
+	uint8_t reg = g->nodes[dec].op.instr;
+	if(reg != INS_DEX && reg != INS_DEY) return 0;
+
+	uint8_t ld = peekPrg(head->addr-2);
+	if(!((ld == 0xa2 && reg == INS_DEX) || (ld == 0xa0 && reg == INS_DEY))) return 0;
+	if(findNode(g, head->addr-2) < 0) return 0;
+
+	uint8_t n = peekPrg(head->addr-1);
+	return n ? n : 256;
+}
+
+// Longest and shortest path costs from node `from`, over forward edges only
+static void propagate(Graph *g, int from, int backFrom[], int backSlot[], int backCount){
+	for(int i=0;i<g->count;i++){
+		g->distMin[i] = -1;
+		g->distMax[i] = -1;
+		g->predMax[i] = -1;
+	}
+	g->distMin[from] = g->nodes[from].costMin;
+	g->distMax[from] = g->nodes[from].costMax;
+
+	for(int k=0;k<g->count;k++){
+		int i = g->order[k];
+		if(g->distMax[i] < 0) continue;
+		Node *n = &g->nodes[i];
+		for(int s=0;s<2;s++){
+			int j = n->succ[s];
+			if(j < 0) continue;
+
+			int isBack = 0;
+			for(int b=0;b<backCount;b++){
+				if(backFrom[b] == i && backSlot[b] == s) isBack = 1;
+			}
+			if(isBack) continue;
+
+			int extra = s ? n->takenCost : 0;
+			int dMin = g->distMin[i] + extra + g->nodes[j].costMin;
+			int dMax = g->distMax[i] + extra + g->nodes[j].costMax;
+			if(g->distMin[j] < 0 || dMin < g->distMin[j]) g->distMin[j] = dMin;
+			if(dMax > g->distMax[j]){
+				g->distMax[j] = dMax;
+				g->predMax[j] = i;
+			}
+		}
+	}
+}
+
+static Result analyze(uint16_t entry, int depth, Graph **out){
+	Result res = {0, 0, 0, 0};
+
+	if(!out){
+		for(int i=0;i<memoCount;i++){
+			if(memo[i].addr == entry) return memo[i].res;
+		}
+	}
+	if(depth > MAX_DEPTH){
+		res.unresolved = 1;
+		return res;
+	}
+
+	Graph *g = calloc(1, sizeof(Graph));
+	if(!g){
+		res.unresolved = 1;
+		return res;
+	}
+	buildGraph(g, entry, depth);
+
+	// Depth-first search for back edges and a reverse postorder
+	int state[MAX_NODES] = {0}; // 0: unvisited, 1: on stack, 2: done
+	int stack[MAX_NODES], slot[MAX_NODES];
+	int backFrom[MAX_NODES], backSlot[MAX_NODES], backCount = 0;
+	int sp = 0, post = g->count;
+	stack[sp] = 0; slot[sp++] = 0;
+	state[0] = 1;
+	while(sp){
+		int i = stack[sp-1];
+		if(slot[sp-1] == 2){
+			state[i] = 2;
+			g->order[--post] = i;
+			sp--;
+			continue;
+		}
+		int s = slot[sp-1]++;
+		int j = g->nodes[i].succ[s];
+		if(j < 0) continue;
+		if(state[j] == 1){
+			backFrom[backCount] = i;
+			backSlot[backCount++] = s;
+		} else if(!state[j]){
+			state[j] = 1;
+			stack[sp] = j;
+			slot[sp++] = 0;
+		}
+	}
+	// Unreachable leftovers (shouldn't happen) go first so they're harmless
+	for(int i=0;i<g->count && post;i++){
+		if(!state[i]) g->order[--post] = i;
+	}
+
+	// Fold loops into their branch node, innermost (shortest) first
+	for(int a=0;a<backCount;a++){
+		for(int b=a+1;b<backCount;b++){
+			Node *na = &g->nodes[backFrom[a]], *nb = &g->nodes[backFrom[b]];
+			int la = na->addr - g->nodes[na->succ[backSlot[a]]].addr;
+			int lb = nb->addr - g->nodes[nb->succ[backSlot[b]]].addr;
+			if(lb < la){
+				int t = backFrom[a]; backFrom[a] = backFrom[b]; backFrom[b] = t;
+				t = backSlot[a]; backSlot[a] = backSlot[b]; backSlot[b] = t;
+			}
+		}
+	}
+	for(int b=0;b<backCount;b++){
+		Node *br = &g->nodes[backFrom[b]];
+		int head = br->succ[backSlot[b]];
+		int iterations = loopCount(g, br, &g->nodes[head]);
+		if(!iterations){
+			g->loops++;
+			continue;
+		}
+		propagate(g, head, backFrom, backSlot, backCount);
+		if(g->distMax[backFrom[b]] < 0) continue;
+
+		int taken = backSlot[b] ? br->takenCost : 0;
+		br->costMin += (iterations-1) * (g->distMin[backFrom[b]] + taken);
+		br->costMax += (iterations-1) * (g->distMax[backFrom[b]] + taken);
+	}
+
+	propagate(g, 0, backFrom, backSlot, backCount);
+	res.best = -1;
+	for(int i=0;i<g->count;i++){
+		if(!g->nodes[i].exit || g->distMax[i] < 0) continue;
+		if(g->nodes[i].exit == EXIT_UNRESOLVED) g->unresolved = 1;
+		if(res.best < 0 || g->distMin[i] < res.best) res.best = g->distMin[i];
+		if(g->distMax[i] > res.worst) res.worst = g->distMax[i];
+	}
+	if(res.best < 0) res.best = 0;
+	res.loops = g->loops;
+	res.unresolved = g->unresolved;
+
+	if(memoCount < MAX_MEMO){
+		memo[memoCount].addr = entry;
+		memo[memoCount++].res = res;
+	}
+	if(out) *out = g;
+	else free(g);
+	return res;
+}
+
+// Length of vblank in CPU cycles for the ROM's region
+int vblankCycles(const char **regionName){
+	// Multi-region ROMs have to fit the shortest (NTSC) vblank
+	uint8_t region = isNes2 ? iNesHeader[12]&0x03 : 0;
+	const char *names[] = {"NTSC", "PAL", "multi-region", "Dendy"};
+	if(regionName) *regionName = names[region];
+
+	// Dendy's NMI is delayed to leave the same vblank length as NTSC
+	return region == 1 ? VBLANK_PAL : VBLANK_NTSC;
+}
+
+void printNmiBudget(){
+	const char *region;
+	int budget = vblankCycles(&region);
+	Graph *g = NULL;
+
+	memoCount = 0;
+	Result res = analyze(vectors[0], 0, &g);
+	if(!g){
+		printf("NMI cycle budget analysis failed: memory error.\n\n");
+		return;
+	}
+	res.best += NMI_ENTRY;
+	res.worst += NMI_ENTRY;
+
+	printf("NMI handler cycle budget (%s vblank: %d cycles):\n", region, budget);
+	printf(" Best case:  %d cycles\n", res.best);
+	printf(" Worst case: %d cycles", res.worst);
+	if(res.worst > budget) printf(" (over budget by %d)", res.worst - budget);
+	printf("\n\n");
+
+	for(int i=0;i<g->count;i++){
+		Node *n = &g->nodes[i];
+		if(!n->exit || g->distMax[i] < 0) continue;
+		printf(
+			" Path to %s at L%04X: %d-%d cycles%s\n",
+			n->exit == EXIT_RETURN ? mnemonics[n->op.instr] : "unresolved exit",
+			n->addr, g->distMin[i] + NMI_ENTRY, g->distMax[i] + NMI_ENTRY,
+			g->distMax[i] + NMI_ENTRY > budget ? " OVERRUNS VBLANK" : ""
+		);
+	}
+
+	// Walk the worst-case path backwards and list where it leaves straight-line code
+	int worstExit = -1;
+	for(int i=0;i<g->count;i++){
+		if(g->nodes[i].exit && g->distMax[i] >= 0 && (worstExit < 0 || g->distMax[i] > g->distMax[worstExit]))
+			worstExit = i;
+	}
+	if(worstExit >= 0){
+		int path[MAX_NODES], len = 0;
+		for(int i=worstExit; i>=0 && len<MAX_NODES; i=g->predMax[i]) path[len++] = i;
+		printf(" Worst-case path:");
+		for(int k=len-1;k>=0;k--){
+			Node *n = &g->nodes[path[k]];
+			uint16_t next = n->addr + instruction_length[n->op.addr_mode];
+			int segStart = k == len-1 || g->nodes[path[k+1]].addr + instruction_length[g->nodes[path[k+1]].op.addr_mode] != n->addr;
+			int segEnd = k == 0 || g->nodes[path[k-1]].addr != next;
+			if(segStart) printf(" L%04X", n->addr);
+			if(segEnd) printf("-L%04X", n->addr);
+		}
+		printf("\n");
+	}
+
+	if(worstExit < 0)
+		printf(" Note: no exit is reachable; the handler never returns\n");
+	if(res.loops)
+		printf(" Note: %d loop(s) with unknown iteration count were counted once\n", res.loops);
+	if(res.unresolved)
+		printf(" Note: some paths end in indirect jumps or unknown code; worst case may be higher\n");
+	printf("\n");
+	free(g);
+}
@@ -0,0 +1,19 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_BUDGET_H
+#define FC_BUDGET_H
+
+#include <stdint.h>
+
+// Cycles from the NMI to the end of vblank
+#define VBLANK_NTSC 2273
+#define VBLANK_PAL  7459
+
+int vblankCycles(const char **regionName);
+void printNmiBudget();
+
+#endif
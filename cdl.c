@@ -0,0 +1,153 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "base.h"
+#include "cdl.h"
+#include "disasm.h"
+#include "instructions.h"
+
+// Code/Data Logger files: one flag byte per PRG-ROM byte, then optionally one per
+//  CHR-ROM byte (FCEUX, Mesen), or the same after a "CDLv2" + CRC32 header (Mesen 2).
+// The log is mapped read-only and used in place.
+
+#define CDL_V2_HEADER 9
+
+const uint8_t *cdlPrg;
+const uint8_t *cdlChr;
+char cdlPath[4096];
+
+static void *cdlMap;
+static size_t cdlMapSize;
+static int cdlHasBanks; // Flags carry the CPU window of each access
+
+static uint8_t mapFile(const char *path){
+	struct stat st;
+	int fd = open(path, O_RDONLY);
+	if(fd < 0) return 1;
+	if(fstat(fd, &st) || !st.st_size){
+		close(fd);
+		return 1;
+	}
+	void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(map == MAP_FAILED) return 1;
+
+	cdlMap = map;
+	cdlMapSize = st.st_size;
+	return 0;
+}
+
+// Map the log next to the ROM, named like the ROM with a .cdl extension (as FCEUX
+//  saves it) or with .cdl appended; return nonzero if there's no usable log
+uint8_t loadCdl(const char *romPath){
+	size_t prgLen = prgSize*16*1024, chrLen = chrSize*8*1024;
+	const char *dot = strrchr(romPath, '.');
+	const char *slash = strrchr(romPath, '/');
+	uint8_t err = 1;
+
+	if(dot && (!slash || dot > slash)){
+		snprintf(cdlPath, sizeof(cdlPath), "%.*s.cdl", (int)(dot-romPath), romPath);
+		err = mapFile(cdlPath);
+	}
+	if(err){
+		snprintf(cdlPath, sizeof(cdlPath), "%s.cdl", romPath);
+		err = mapFile(cdlPath);
+	}
+	if(err) return 1;
+
+	const uint8_t *data = cdlMap;
+	size_t len = cdlMapSize;
+	cdlHasBanks = 1;
+	if(len >= CDL_V2_HEADER && !memcmp(data, "CDLv2", 5)){
+		data += CDL_V2_HEADER;
+		len -= CDL_V2_HEADER;
+		cdlHasBanks = 0;
+	}
+	if(!prgLen || (len != prgLen && len != prgLen+chrLen)){
+		fprintf(stderr, "Ignoring %s: its size doesn't match the ROM.\n", cdlPath);
+		unloadCdl();
+		return 1;
+	}
+	cdlPrg = data;
+	cdlChr = (chrLen && len == prgLen+chrLen) ? data+prgLen : NULL;
+	return 0;
+}
+
+void unloadCdl(){
+	if(cdlMap) munmap(cdlMap, cdlMapSize);
+	cdlMap = NULL;
+	cdlPrg = cdlChr = NULL;
+}
+
+// Return the CPU address a PRG-ROM byte was logged at, falling back to the fixed-bank
+//  view (or the bank's offset from $8000) when the log doesn't say
+uint16_t cdlAddress(uint32_t offset){
+	if(cdlHasBanks && (cdlPrg[offset] & (CDL_CODE|CDL_DATA)))
+		return 0x8000 | (cdlPrg[offset] & CDL_BANK_MASK)<<11 | (offset & 0x1fff);
+	int32_t addr = cpuAddress(offset);
+	return addr < 0 ? 0x8000 | (offset & 0x3fff) : (uint32_t)addr;
+}
+
+// Disassemble every run of logged code, in every bank; expects prgRom to be loaded
+void disassembleLogged(){
+	static const char *const vectorNames[] = {"nmi", "reset", "irq"};
+	uint32_t end = prgSize*16*1024;
+	char str[128];
+
+	for(uint32_t i=0;i<end;){
+		if(!(cdlPrg[i] & CDL_CODE)){
+			i++;
+			continue;
+		}
+		printf("\n; Bank %d, offset 0x%06x\n", i/(16*1024), i);
+		while(i < end && (cdlPrg[i] & CDL_CODE)){
+			uint8_t bytes[3] = {0};
+			for(uint32_t k=0;k<3 && i+k<end;k++) bytes[k] = prgRom[i+k];
+			Opcode op = opcodes[bytes[0]];
+			uint16_t addr = cdlAddress(i);
+
+			for(int v=0;v<3;v++){
+				if(cpuAddress(i) == vectors[v]) printf("%s:\n", vectorNames[v]);
+			}
+			disassembleBytes(bytes, addr, str, 128);
+			printf(" %s\t%d%s\n", str, op.cycles, (op.page_cross || op.addr_mode == AM_RELATIVE) ? "+" : "");
+			i += instruction_length[op.addr_mode];
+		}
+	}
+}
+
+// Bytes the log never saw executed, read or drawn; only as honest as the play session
+//  was thorough, but unlike filler runs it also finds unused non-blank data
+void printUntouched(){
+	printf("Never touched while logging (%s):\n", cdlPath);
+	for(int b=0;b<prgSize;b++){
+		int count = 0;
+		for(uint32_t j=b*16*1024; j<(uint32_t)(b+1)*16*1024; j++) count += !cdlPrg[j];
+		printf(" Untouched bytes in PRG-ROM bank %d: %d bytes\n", b, count);
+	}
+	if(cdlChr){
+		printf("\n");
+		for(int p=0;p<chrSize*2;p++){
+			int count = 0;
+			for(int t=0;t<256;t++){
+				const uint8_t *flags = cdlChr + p*4096 + t*16;
+				int touched = 0;
+				for(int k=0;k<16;k++) touched |= flags[k];
+				count += !touched;
+			}
+			printf(" Untouched tiles in CHR-ROM page %d: %d tiles\n", p, count);
+		}
+	}
+	printf("\n");
+}
@@ -0,0 +1,27 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_CDL_H
+#define FC_CDL_H
+
+#include <stdint.h>
+
+// https://fceux.com/web/help/CodeDataLogger.html
+#define CDL_CODE      0x01
+#define CDL_DATA      0x02
+#define CDL_BANK_MASK 0x0c // FCEUX only: 8 KiB CPU window the byte was accessed through
+
+extern const uint8_t *cdlPrg; // One flag byte per PRG-ROM byte, NULL if no log is loaded
+extern const uint8_t *cdlChr; // One flag byte per CHR-ROM byte, NULL if the log has none
+extern char cdlPath[4096];
+
+uint8_t loadCdl(const char *romPath);
+void unloadCdl();
+uint16_t cdlAddress(uint32_t offset);
+void disassembleLogged();
+void printUntouched();
+
+#endif
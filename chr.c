@@ -0,0 +1,151 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "chr.h"
+
+// Each 8 KiB CHR bank is laid out as a 16x32 tile sheet
+#define SHEET_W 128
+#define SHEET_H 256
+
+// Spread the 8 bits of a byte into the low bit of 8 byte lanes, MSB first,
+//  so a whole tile row can be converted with two lookups and an OR
+static uint64_t bitSpread[256];
+static uint32_t crcTable[256];
+
+static void initTables(){
+	if(bitSpread[1]) return;
+	for(int i=0;i<256;i++){
+		uint64_t v = 0;
+		for(int b=0;b<8;b++){
+			if(i & (0x80>>b)) v |= (uint64_t)1 << (8*b);
+		}
+		bitSpread[i] = v;
+
+		uint32_t c = i;
+		for(int k=0;k<8;k++) c = (c&1) ? 0xedb88320 ^ (c>>1) : c>>1;
+		crcTable[i] = c;
+	}
+}
+
+// Convert a 16-byte 2bpp planar tile into 8x8 palette indices (0-3)
+// NOTE: Assumes a little-endian host
+void chrTileToIndexed(const uint8_t *tile, uint8_t *out, int stride){
+	for(int r=0;r<8;r++){
+		uint64_t px = bitSpread[tile[r]] | bitSpread[tile[r+8]]<<1;
+		memcpy(out + r*stride, &px, 8);
+	}
+}
+
+uint32_t crc32(uint32_t crc, const uint8_t *buf, size_t len){
+	initTables();
+	crc = ~crc;
+	while(len--) crc = crcTable[(crc ^ *buf++)&0xff] ^ (crc>>8);
+	return ~crc;
+}
+
+static void putBe32(uint8_t *p, uint32_t v){
+	p[0] = v>>24; p[1] = v>>16; p[2] = v>>8; p[3] = v;
+}
+
+static void writePngChunk(FILE *fp, const char *type, const uint8_t *data, uint32_t len){
+	uint8_t hdr[8];
+	putBe32(hdr, len);
+	memcpy(hdr+4, type, 4);
+	fwrite(hdr, 8, 1, fp);
+	if(len) fwrite(data, len, 1, fp);
+
+	uint32_t crc = crc32(0, hdr+4, 4);
+	crc = crc32(crc, data, len);
+	putBe32(hdr, crc);
+	fwrite(hdr, 4, 1, fp);
+}
+
+// Write an 8-bit indexed PNG with a 4-shade grayscale palette;
+//  image data is wrapped in stored (uncompressed) deflate blocks
+static void writePng(FILE *fp, const uint8_t *pixels){
+	static uint8_t idat[2 + SHEET_H*(SHEET_W+1) + 5 + 4];
+	const uint32_t rawLen = SHEET_H*(SHEET_W+1);
+	uint8_t ihdr[13] = {0};
+	const uint8_t plte[12] = {
+		0x00, 0x00, 0x00,
+		0x55, 0x55, 0x55,
+		0xaa, 0xaa, 0xaa,
+		0xff, 0xff, 0xff
+	};
+
+	putBe32(ihdr, SHEET_W);
+	putBe32(ihdr+4, SHEET_H);
+	ihdr[8] = 8; // Bit depth
+	ihdr[9] = 3; // Color type: indexed
+
+	// zlib header, then a single final stored block (raw data fits in 64 KiB)
+	uint8_t *p = idat;
+	*p++ = 0x78; *p++ = 0x01;
+	*p++ = 0x01;
+	*p++ = rawLen&0xff; *p++ = rawLen>>8;
+	*p++ = ~rawLen&0xff; *p++ = (~rawLen>>8)&0xff;
+
+	uint32_t a = 1, b = 0;
+	for(int y=0;y<SHEET_H;y++){
+		*p++ = 0; // Filter type: none
+		memcpy(p, pixels + y*SHEET_W, SHEET_W);
+		p += SHEET_W;
+	}
+	for(uint8_t *q = idat+7; q<p; q++){
+		a = (a + *q) % 65521;
+		b = (b + a) % 65521;
+	}
+	putBe32(p, b<<16 | a);
+	p += 4;
+
+	fwrite("\x89PNG\r\n\x1a\n", 8, 1, fp);
+	writePngChunk(fp, "IHDR", ihdr, 13);
+	writePngChunk(fp, "PLTE", plte, 12);
+	writePngChunk(fp, "IDAT", idat, p-idat);
+	writePngChunk(fp, "IEND", NULL, 0);
+}
+
+static void writePgm(FILE *fp, const uint8_t *pixels){
+	fprintf(fp, "P5\n%d %d\n3\n", SHEET_W, SHEET_H);
+	fwrite(pixels, SHEET_W*SHEET_H, 1, fp);
+}
+
+// Write one tile sheet per 8 KiB CHR-ROM bank, named after the ROM file
+uint8_t exportChrSheets(FILE *rom, const char *romPath, chrFormat fmt){
+	static uint8_t bank[8*1024];
+	static uint8_t pixels[SHEET_W*SHEET_H];
+	char path[4096];
+
+	initTables();
+	fseek(rom, 16+hasTrainer*512+16*1024*prgSize, SEEK_SET);
+	for(int i=0;i<chrSize;i++){
+		if(!fread(bank, sizeof(bank), 1, rom)) return 1;
+
+		for(int t=0;t<512;t++){
+			int x = (t%16)*8;
+			int y = (t/16)*8;
+			chrTileToIndexed(&bank[t*16], &pixels[y*SHEET_W + x], SHEET_W);
+		}
+
+		snprintf(path, sizeof(path), "%s.chr%d.%s", romPath, i, fmt == CHR_PNG ? "png" : "pgm");
+		FILE *out = fopen(path, "wb");
+		if(out == NULL){
+			perror("Error writing CHR sheet");
+			return 1;
+		}
+		if(fmt == CHR_PNG) writePng(out, pixels);
+		else writePgm(out, pixels);
+		fclose(out);
+		printf(" %s\n", path);
+	}
+	return 0;
+}
@@ -0,0 +1,22 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_CHR_H
+#define FC_CHR_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef enum chrFormat{
+	CHR_PNG,
+	CHR_PGM
+} chrFormat;
+
+uint32_t crc32(uint32_t crc, const uint8_t *buf, size_t len);
+void chrTileToIndexed(const uint8_t *tile, uint8_t *out, int stride);
+uint8_t exportChrSheets(FILE *rom, const char *romPath, chrFormat fmt);
+
+#endif
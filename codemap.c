@@ -0,0 +1,403 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "cdl.h"
+#include "codemap.h"
+#include "instructions.h"
+
+// Runs of filler bytes at least this long are left unclassified
+#define FILLER_RUN 16
+// Runs of a repeated non-filler byte at least this long are treated as data
+#define DATA_RUN 4
+// Instructions looked back at to recognize a dispatch idiom
+#define DISPATCH_WINDOW 16
+// Entries read from a dispatch table with no bounds check in sight
+#define DISPATCH_MAX_ENTRIES 64
+#define DISPATCH_MAX_TABLES 256
+
+uint8_t *codeMap;
+
+enum _dispatch_kinds{
+	DISPATCH_RTS,    // Address pushed on the stack, then RTS
+	DISPATCH_JMP,    // JMP (ptr)
+	DISPATCH_INLINE  // Table after a JSR to a jump engine
+};
+
+static const char *const dispatchKindNames[] = {"RTS", "JMP ()", "inline"};
+
+typedef struct{
+	uint16_t site;   // Address of the dispatching instruction
+	uint8_t  kind;
+	uint16_t lo, hi; // Low and high byte tables; hi == lo+1 for tables of words
+	int      entries;
+} DispatchTable;
+
+static DispatchTable dispatchTables[DISPATCH_MAX_TABLES];
+static int dispatchCount, dispatchTargets;
+static int resolveTables;
+static long tracedBytes, baselineBytes; // Code and operand bytes reached, with and without tables
+
+static uint32_t *pendingTables; // PRG offsets of indexed tables to mark once tracing is done
+static int pendingCount, pendingCap;
+
+// Mark a referenced table as data, stopping at classified bytes or long filler runs
+static void markTable(uint32_t offset, int maxLen){
+	uint32_t end = prgSize*16*1024;
+	int run = 0;
+	for(int i=0; i<maxLen && offset+i < end; i++){
+		uint8_t ch = prgRom[offset+i];
+		if(cmGet(offset+i) != CM_UNKNOWN) break;
+		run = (i && ch == prgRom[offset+i-1] && (!ch || ch == 0xff)) ? run+1 : 0;
+		if(run >= FILLER_RUN) break;
+		cmSet(offset+i, CM_DATA);
+	}
+}
+
+// Indexed tables are only marked once tracing is done, so that a table can't swallow
+//  code that a later path (often a jump table's handler) reaches
+static void deferTable(uint32_t offset){
+	if(pendingCount == pendingCap){
+		int cap = pendingCap ? pendingCap*2 : 256;
+		uint32_t *grown = realloc(pendingTables, cap*sizeof(uint32_t));
+		if(!grown) return;
+		pendingTables = grown;
+		pendingCap = cap;
+	}
+	pendingTables[pendingCount++] = offset;
+}
+
+static uint16_t romWord(uint16_t addr){
+	return peekPrg(addr) | peekPrg(addr+1)<<8;
+}
+
+static Opcode opcodeAt(uint16_t addr){
+	return opcodes[peekPrg(addr)];
+}
+
+// Stores and read-modify-writes into ROM are mapper register writes, not table reads
+static int readsOperand(uint8_t instr){
+	switch(instr){
+		case INS_LDA:
+		case INS_LDX:
+		case INS_LDY:
+		case INS_ADC:
+		case INS_SBC:
+		case INS_AND:
+		case INS_ORA:
+		case INS_EOR:
+		case INS_CMP:
+		case INS_CPX:
+		case INS_CPY:
+		case INS_BIT:
+		return 1;
+
+		default:
+		return 0;
+	}
+}
+
+static int isIndexedLoad(Opcode op){
+	return op.instr == INS_LDA && (op.addr_mode == AM_INDEXED_ABSOLUTE_X || op.addr_mode == AM_INDEXED_ABSOLUTE_Y);
+}
+
+// Entry count given by a CMP/CPX/CPY #n bounds check among the first n instructions
+static int boundCheck(const uint16_t *recent, int n){
+	for(int i=n-1;i>=0;i--){
+		Opcode op = opcodeAt(recent[i]);
+		if((op.instr == INS_CMP || op.instr == INS_CPX || op.instr == INS_CPY) && op.addr_mode == AM_IMMEDIATE)
+			return peekPrg(recent[i]+1) ? peekPrg(recent[i]+1) : DISPATCH_MAX_ENTRIES;
+	}
+	return DISPATCH_MAX_ENTRIES;
+}
+
+// Read a table of code addresses made of low and high bytes at lo and hi, stride step;
+//  targets are the words plus bias. The table ends at the bound, at a bad target, or
+//  where it runs into the first handler after it. Targets go on the trace stack, the
+//  table is marked as data and recorded; return the number of entries
+static int readDispatchTable(uint16_t site, uint8_t kind, uint16_t lo, uint16_t hi, int step, int bias, int maxEntries, uint16_t *stack, int *sp){
+	uint16_t first = lo < hi ? lo : hi;
+	uint32_t nextHandler = 0x10000;
+	int n;
+
+	// Split tables can't overlap each other
+	if(step == 1 && hi != lo) maxEntries = abs(hi-lo) < maxEntries ? abs(hi-lo) : maxEntries;
+
+	for(n=0;n<maxEntries;n++){
+		uint16_t a = lo + n*step, b = hi + n*step;
+		int32_t oa = prgOffset(a), ob = prgOffset(b);
+		if(oa < 0 || ob < 0 || a >= nextHandler || b >= nextHandler) break;
+		uint8_t ca = cmGet(oa), cb = cmGet(ob);
+		if(ca == CM_CODE || ca == CM_OPERAND || cb == CM_CODE || cb == CM_OPERAND) break;
+
+		uint16_t target = (prgRom[oa] | prgRom[ob]<<8) + bias;
+		int32_t ot = prgOffset(target);
+		if(ot < 0 || opcodes[prgRom[ot]].instr == INS_INV) break;
+		if(cmGet(ot) == CM_DATA || cmGet(ot) == CM_OPERAND) break;
+		if(target >= first && target <= (a > b ? a : b)) break;
+
+		if(target > first && target < nextHandler) nextHandler = target;
+		if(*sp < 1024) stack[(*sp)++] = target;
+	}
+	if(!n) return 0;
+
+	for(int i=0;i<n;i++){
+		int32_t oa = prgOffset(lo + i*step), ob = prgOffset(hi + i*step);
+		if(cmGet(oa) == CM_UNKNOWN) cmSet(oa, CM_DATA);
+		if(cmGet(ob) == CM_UNKNOWN) cmSet(ob, CM_DATA);
+	}
+	if(dispatchCount < DISPATCH_MAX_TABLES)
+		dispatchTables[dispatchCount] = (DispatchTable){site, kind, lo, hi, n};
+	dispatchCount++;
+	dispatchTargets += n;
+	return n;
+}
+
+// Resolve the dispatch ending the recent[] instructions (oldest first):
+//  LDA hi,X / PHA / LDA lo,X / PHA / RTS       pushes target-1, RTS jumps there
+//  LDA lo,X / STA ptr / LDA hi,X / STA ptr+1 / JMP (ptr)
+//  JMP (addr) with addr in ROM                 fixed pointer
+static void resolveDispatch(const uint16_t *recent, int n, uint16_t *stack, int *sp){
+	uint16_t site = recent[n-1];
+	Opcode op = opcodeAt(site);
+
+	if(op.instr == INS_RTS && n >= 5){
+		Opcode ldHi = opcodeAt(recent[n-5]), ldLo = opcodeAt(recent[n-3]);
+		if(
+			opcodeAt(recent[n-4]).instr != INS_PHA || opcodeAt(recent[n-2]).instr != INS_PHA ||
+			!isIndexedLoad(ldHi) || ldHi.addr_mode != ldLo.addr_mode
+		) return;
+		uint16_t lo = romWord(recent[n-3]+1), hi = romWord(recent[n-5]+1);
+		readDispatchTable(site, DISPATCH_RTS, lo, hi, hi == lo+1 ? 2 : 1, 1, boundCheck(recent, n-5), stack, sp);
+		return;
+	}
+	if(op.instr != INS_JMP || op.addr_mode != AM_ABSOLUTE_INDIRECT) return;
+
+	uint16_t ptr = romWord(site+1);
+	if(prgOffset(ptr) >= 0 && prgOffset(ptr+1) >= 0){
+		readDispatchTable(site, DISPATCH_JMP, ptr, ptr+1, 2, 0, 1, stack, sp);
+		return;
+	}
+
+	// Most recent stores to both pointer bytes, each right after an indexed load
+	int storeLo = -1, storeHi = -1;
+	for(int i=n-2;i>=1;i--){
+		Opcode st = opcodeAt(recent[i]);
+		if(st.instr != INS_STA || (st.addr_mode != AM_ZEROPAGE && st.addr_mode != AM_ABSOLUTE)) continue;
+		uint16_t dst = st.addr_mode == AM_ZEROPAGE ? peekPrg(recent[i]+1) : romWord(recent[i]+1);
+		if(dst == ptr && storeLo < 0) storeLo = i;
+		if(dst == (uint16_t)(ptr+1) && storeHi < 0) storeHi = i;
+	}
+	if(storeLo < 0 || storeHi < 0) return;
+	Opcode ldLo = opcodeAt(recent[storeLo-1]), ldHi = opcodeAt(recent[storeHi-1]);
+	if(!isIndexedLoad(ldLo) || ldLo.addr_mode != ldHi.addr_mode) return;
+
+	uint16_t lo = romWord(recent[storeLo-1]+1), hi = romWord(recent[storeHi-1]+1);
+	int firstLoad = (storeLo < storeHi ? storeLo : storeHi) - 1;
+	readDispatchTable(site, DISPATCH_JMP, lo, hi, hi == lo+1 ? 2 : 1, 0, boundCheck(recent, firstLoad), stack, sp);
+}
+
+// Subroutines that dispatch through a table inlined after the JSR calling them:
+//  ASL A / TAY / PLA / STA ptr / PLA / STA ptr+1 (e.g. Super Mario Bros.' JumpEngine)
+static int isJumpEngine(uint16_t addr){
+	static const uint8_t head[] = {0x0a, 0xa8, 0x68, 0x85};
+	for(int i=0;i<4;i++) if(prgOffset(addr+i) < 0 || peekPrg(addr+i) != head[i]) return 0;
+	return peekPrg(addr+5) == 0x68 && peekPrg(addr+6) == 0x85 && peekPrg(addr+7) == (uint8_t)(peekPrg(addr+4)+1);
+}
+
+// Follow control flow from addr, marking decoded instructions
+static void trace(uint16_t start){
+	uint16_t stack[1024];
+	uint16_t recent[DISPATCH_WINDOW]; // Last instructions of the current path, oldest first
+	int sp = 0;
+	stack[sp++] = start;
+
+	while(sp){
+		uint16_t addr = stack[--sp];
+		int n = 0;
+		for(;;){
+			int32_t offset = prgOffset(addr);
+			if(offset < 0 || cmGet(offset) != CM_UNKNOWN) break;
+
+			Opcode op = opcodes[prgRom[offset]];
+			uint8_t len = instruction_length[op.addr_mode];
+			if(op.instr == INS_INV) break;
+
+			// Don't let an instruction overlap bytes already claimed
+			int overlap = 0;
+			for(int i=1;i<len;i++){
+				int32_t o = prgOffset(addr+i);
+				if(o < 0 || cmGet(o) != CM_UNKNOWN) overlap = 1;
+			}
+			if(overlap) break;
+
+			cmSet(offset, CM_CODE);
+			for(int i=1;i<len;i++) cmSet(prgOffset(addr+i), CM_OPERAND);
+			tracedBytes += len;
+			if(n == DISPATCH_WINDOW){
+				memmove(recent, recent+1, (n-1)*sizeof(uint16_t));
+				n--;
+			}
+			recent[n++] = addr;
+
+			uint16_t param16 = 0;
+			if(len == 3) param16 = prgRom[prgOffset(addr+1)] | prgRom[prgOffset(addr+2)]<<8;
+			uint16_t nextAddr = addr + len;
+
+			if(op.addr_mode == AM_RELATIVE){
+				if(sp < 1024) stack[sp++] = relative_addr(nextAddr, (int8_t)prgRom[prgOffset(addr+1)]);
+			} else if(op.instr == INS_JSR){
+				// An inline jump table follows the JSR instead of more code
+				if(resolveTables && isJumpEngine(param16)){
+					readDispatchTable(addr, DISPATCH_INLINE, nextAddr, nextAddr+1, 2, 0, DISPATCH_MAX_ENTRIES, stack, &sp);
+					if(sp < 1024) stack[sp++] = param16;
+					break;
+				}
+				if(sp < 1024) stack[sp++] = param16;
+			} else if(op.instr == INS_JMP && op.addr_mode == AM_ABSOLUTE){
+				nextAddr = param16;
+			} else if(len == 3 && readsOperand(op.instr) && prgOffset(param16) >= 0){
+				// Absolute operand pointing into ROM: the start of a data table
+				int indexed = op.addr_mode == AM_INDEXED_ABSOLUTE_X || op.addr_mode == AM_INDEXED_ABSOLUTE_Y;
+				if(cmGet(prgOffset(param16)) == CM_UNKNOWN) cmSet(prgOffset(param16), CM_DATA);
+				if(indexed) deferTable(prgOffset(param16)+1);
+			}
+
+			if(resolveTables && (op.instr == INS_RTS || op.instr == INS_JMP)) resolveDispatch(recent, n, stack, &sp);
+			// An absolute JMP continues the trace at its target
+			if(op.instr == INS_JMP && op.addr_mode != AM_ABSOLUTE) break;
+			if(op.instr == INS_RTS || op.instr == INS_RTI || op.instr == INS_BRK) break;
+			addr = nextAddr;
+		}
+	}
+}
+
+// Classify unknown bytes that can't plausibly be code or padding
+static void markHeuristicData(uint32_t start, uint32_t end){
+	uint32_t i = start;
+	while(i < end){
+		if(cmGet(i) != CM_UNKNOWN){
+			i++;
+			continue;
+		}
+
+		// Find the run of identical bytes starting here
+		uint32_t j = i;
+		while(j < end && prgRom[j] == prgRom[i] && cmGet(j) == CM_UNKNOWN) j++;
+		uint8_t isFiller = (!prgRom[i] || prgRom[i] == 0xff);
+		if(isFiller && j-i >= FILLER_RUN){
+			i = j;
+			continue;
+		}
+
+		// Repeated non-filler bytes or invalid opcodes outside padding
+		if((!isFiller && j-i >= DATA_RUN) || (!isFiller && opcodes[prgRom[i]].instr == INS_INV)){
+			for(uint32_t k=i;k<j;k++) cmSet(k, CM_DATA);
+		}
+		i = j;
+	}
+}
+
+// A code/data log is ground truth: logged code is decoded along its runs (loggers mark
+//  every byte of an executed instruction) and logged data is data
+static void markLogged(uint32_t start, uint32_t end){
+	for(uint32_t i=start;i<end;){
+		if(cdlPrg[i] & CDL_CODE){
+			uint8_t len = instruction_length[opcodes[prgRom[i]].addr_mode];
+			cmSet(i, CM_CODE);
+			for(uint32_t k=1;k<len && i+k<end;k++) cmSet(i+k, CM_OPERAND);
+			i += len;
+		} else{
+			if(cdlPrg[i] & CDL_DATA) cmSet(i, CM_DATA);
+			i++;
+		}
+	}
+}
+
+// Classify the bytes of a bank the trace left alone; banks are mapped independently,
+//  so runs and logged instructions never continue into the next one
+static void markBank(int bank){
+	uint32_t start = bank*16*1024, end = start + 16*1024;
+	markHeuristicData(start, end);
+	if(cdlPrg) markLogged(start, end);
+}
+
+// Build the code/data map of the whole PRG-ROM by tracing from the hardware vectors,
+//  then applying the code/data log if one is loaded
+// Expects vectors[] to have been read
+uint8_t buildCodeMap(FILE *rom){
+	if(codeMap) return 0;
+	if(loadPrgRom(rom)) return 1;
+
+	codeMap = calloc(prgSize*16*1024/4, 1);
+	if(!codeMap) return 1;
+
+	// Plain traversal first, only to measure what dispatch resolution adds
+	resolveTables = 0;
+	tracedBytes = 0;
+	for(int i=0;i<3;i++) trace(vectors[i]);
+	baselineBytes = tracedBytes;
+	memset(codeMap, 0, prgSize*16*1024/4);
+
+	resolveTables = 1;
+	tracedBytes = pendingCount = dispatchCount = dispatchTargets = 0;
+	for(int i=0;i<3;i++) trace(vectors[i]);
+	for(int i=0;i<pendingCount;i++) markTable(pendingTables[i], 255);
+	free(pendingTables);
+	pendingTables = NULL;
+	pendingCount = pendingCap = 0;
+	for(int i=0;i<prgSize;i++) markBank(i);
+	return 0;
+}
+
+// Reclassify a bank outside the fixed-bank view after its bytes in prgRom changed; the
+//  trace never reaches such banks, so the rest of the map stays valid
+void remapBank(int bank){
+	memset(codeMap + bank*16*1024/4, 0, 16*1024/4);
+	markBank(bank);
+}
+
+// Write the packed map to a file
+uint8_t exportCodeMap(const char *path){
+	FILE *out = fopen(path, "wb");
+	if(out == NULL){
+		perror("Error writing code map");
+		return 1;
+	}
+	fwrite(codeMap, prgSize*16*1024/4, 1, out);
+	fclose(out);
+	return 0;
+}
+
+void printCodeMapSummary(){
+	printf("PRG-ROM code/data map:\n");
+	for(int i=0;i<prgSize;i++){
+		int cnt[4] = {0};
+		for(uint32_t j=i*16*1024; j<(uint32_t)(i+1)*16*1024; j++) cnt[cmGet(j)]++;
+		printf(
+			" Bank %d: %d code, %d operand, %d data, %d unknown bytes\n",
+			i, cnt[CM_CODE], cnt[CM_OPERAND], cnt[CM_DATA], cnt[CM_UNKNOWN]
+		);
+	}
+	printf("\n");
+
+	printf(
+		" Reachable code: %ld bytes (%.1f%% of PRG-ROM), %ld without dispatch resolution\n",
+		tracedBytes, 100.0*tracedBytes/(prgSize*16*1024), baselineBytes
+	);
+	printf(" Dispatch tables resolved: %d (%d targets)\n", dispatchCount, dispatchTargets);
+	for(int i=0;i<dispatchCount && i<DISPATCH_MAX_TABLES;i++){
+		DispatchTable *t = &dispatchTables[i];
+		if(t->hi == t->lo+1) printf("  $%04x: %-6s table at $%04x, %d entries\n", t->site, dispatchKindNames[t->kind], t->lo, t->entries);
+		else printf("  $%04x: %-6s tables at $%04x/$%04x, %d entries\n", t->site, dispatchKindNames[t->kind], t->lo, t->hi, t->entries);
+	}
+	printf("\n");
+}
@@ -0,0 +1,37 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_CODEMAP_H
+#define FC_CODEMAP_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+enum _byte_classes{
+	CM_UNKNOWN,
+	CM_CODE,    // First byte of an instruction
+	CM_OPERAND, // Instruction operand
+	CM_DATA
+};
+
+// 2 bits per PRG-ROM byte, 4 bytes per map byte (lowest bits first)
+extern uint8_t *codeMap;
+
+static inline uint8_t cmGet(uint32_t offset){
+	return (codeMap[offset>>2] >> ((offset&3)*2)) & 3;
+}
+
+static inline void cmSet(uint32_t offset, uint8_t cls){
+	uint8_t shift = (offset&3)*2;
+	codeMap[offset>>2] = (codeMap[offset>>2] & ~(3<<shift)) | cls<<shift;
+}
+
+uint8_t buildCodeMap(FILE *rom);
+void remapBank(int bank);
+uint8_t exportCodeMap(const char *path);
+void printCodeMapSummary();
+
+#endif
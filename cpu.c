@@ -0,0 +1,275 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "base.h"
+#include "cpu.h"
+#include "instructions.h"
+
+// Minimal 6502 core running from the fixed-bank view of PRG-ROM (see getLastBankOffset).
+// The bus only models RAM, PRG-RAM and a stub PPU; writes to 0x8000-0xFFFF are logged
+//  as mapper register writes but don't switch banks.
+
+// CPU cycles between emulated NMIs (one NTSC frame)
+#define NMI_INTERVAL 29781
+
+#define FLAG_C 0x01
+#define FLAG_Z 0x02
+#define FLAG_I 0x04
+#define FLAG_D 0x08
+#define FLAG_B 0x10
+#define FLAG_U 0x20
+#define FLAG_V 0x40
+#define FLAG_N 0x80
+
+static uint8_t busRead(Cpu *cpu, uint16_t addr){
+	if(addr < 0x2000) return cpu->ram[addr&0x7ff];
+	if(addr < 0x4000){
+		if((addr&7) != 2) return 0;
+		// Toggle VBL and sprite 0 hit so polling loops in either direction finish
+		cpu->ppuStatus ^= 0xc0;
+		return cpu->ppuStatus;
+	}
+	if(addr < 0x6000) return 0; // APU and I/O
+	if(addr < 0x8000) return cpu->prgRam[addr&0x1fff];
+
+	return peekPrg(addr);
+}
+
+static void busWrite(Cpu *cpu, uint16_t addr, uint8_t val){
+	if(addr < 0x2000){
+		cpu->ram[addr&0x7ff] = val;
+	} else if(addr < 0x4000){
+		if((addr&7) == 0) cpu->nmiEnabled = val&0x80;
+	} else if(addr < 0x6000){
+		if(addr == 0x4014) cpu->cycles += OAM_DMA_CYCLES;
+	} else if(addr < 0x8000){
+		cpu->prgRam[addr&0x1fff] = val;
+	} else if(cpu->writeCount < CPU_MAX_WRITES){
+		MapperWrite *w = &cpu->writes[cpu->writeCount++];
+		w->cycle = cpu->cycles;
+		w->pc = cpu->pc;
+		w->addr = addr;
+		w->val = val;
+	}
+}
+
+static inline void push(Cpu *cpu, uint8_t val){
+	cpu->ram[0x100 | cpu->s--] = val;
+}
+
+static inline uint8_t pull(Cpu *cpu){
+	return cpu->ram[0x100 | ++cpu->s];
+}
+
+static inline uint8_t setNZ(Cpu *cpu, uint8_t val){
+	cpu->p = (cpu->p & ~(FLAG_N|FLAG_Z)) | (val&FLAG_N) | (val ? 0 : FLAG_Z);
+	return val;
+}
+
+static inline uint16_t read16(Cpu *cpu, uint16_t addr){
+	return busRead(cpu, addr) | busRead(cpu, addr+1)<<8;
+}
+
+// Same as read16, but with the 6502 page wrap bug for indirect pointers
+static inline uint16_t read16Wrap(Cpu *cpu, uint16_t addr){
+	uint16_t hi = (addr&0xff00) | ((addr+1)&0x00ff);
+	return busRead(cpu, addr) | busRead(cpu, hi)<<8;
+}
+
+static void interrupt(Cpu *cpu, uint16_t vector, uint8_t brk){
+	push(cpu, cpu->pc>>8);
+	push(cpu, cpu->pc&0xff);
+	push(cpu, cpu->p | FLAG_U | (brk ? FLAG_B : 0));
+	cpu->p |= FLAG_I;
+	cpu->pc = read16(cpu, vector);
+	cpu->cycles += 7;
+}
+
+static inline void compare(Cpu *cpu, uint8_t reg, uint8_t val){
+	cpu->p = (cpu->p & ~FLAG_C) | (reg >= val ? FLAG_C : 0);
+	setNZ(cpu, reg - val);
+}
+
+// The 2A03 has no decimal mode, so ADC/SBC are always binary
+static inline void addWithCarry(Cpu *cpu, uint8_t val){
+	uint16_t sum = cpu->a + val + (cpu->p&FLAG_C);
+	cpu->p &= ~(FLAG_C|FLAG_V);
+	if(sum > 0xff) cpu->p |= FLAG_C;
+	if(~(cpu->a ^ val) & (cpu->a ^ sum) & 0x80) cpu->p |= FLAG_V;
+	setNZ(cpu, cpu->a = sum);
+}
+
+void cpuReset(Cpu *cpu){
+	memset(cpu, 0, sizeof(Cpu));
+	cpu->s = 0xfd;
+	cpu->p = FLAG_I | FLAG_U;
+	cpu->pc = read16(cpu, 0xfffc);
+}
+
+cpuStop cpuRun(Cpu *cpu, uint64_t maxCycles){
+	uint64_t nextNmi = NMI_INTERVAL;
+	while(cpu->cycles < maxCycles){
+		if(cpu->cycles >= nextNmi){
+			nextNmi += NMI_INTERVAL;
+			if(cpu->nmiEnabled) interrupt(cpu, 0xfffa, 0);
+		}
+
+		uint16_t pc = cpu->pc;
+		if(pc >= 0x2000 && pc < 0x6000) return STOP_BAD_FETCH;
+
+		Opcode op = opcodes[busRead(cpu, pc)];
+		uint16_t addr = 0;
+		uint16_t base = 0;
+		uint16_t next = pc + instruction_length[op.addr_mode];
+		uint8_t  p8 = busRead(cpu, pc+1);
+
+		switch(op.addr_mode){
+			case AM_IMMEDIATE:         addr = pc+1; break;
+			case AM_ABSOLUTE:          addr = read16(cpu, pc+1); break;
+			case AM_ZEROPAGE:          addr = p8; break;
+			case AM_INDEXED_ZEROPAGE_X: addr = (uint8_t)(p8 + cpu->x); break;
+			case AM_INDEXED_ZEROPAGE_Y: addr = (uint8_t)(p8 + cpu->y); break;
+			case AM_INDEXED_ABSOLUTE_X: base = read16(cpu, pc+1); addr = base + cpu->x; break;
+			case AM_INDEXED_ABSOLUTE_Y: base = read16(cpu, pc+1); addr = base + cpu->y; break;
+			case AM_RELATIVE:          addr = relative_addr(next, (int8_t)p8); break;
+			case AM_INDEXED_INDIRECT_X: addr = read16Wrap(cpu, (uint8_t)(p8 + cpu->x)); break;
+			case AM_INDIRECT_INDEXED_Y: base = read16Wrap(cpu, p8); addr = base + cpu->y; break;
+			case AM_ABSOLUTE_INDIRECT: addr = read16Wrap(cpu, read16(cpu, pc+1)); break;
+			default:;
+		}
+
+		uint8_t acc = op.addr_mode == AM_ACCUMULATOR;
+		cpu->cycles += op.cycles;
+		if(op.page_cross) cpu->cycles += page_crossed(base, addr);
+		uint8_t val, c, taken = 0;
+
+		switch(op.instr){
+			case INS_INV:
+			return STOP_INVALID;
+
+			case INS_ADC: addWithCarry(cpu, busRead(cpu, addr)); break;
+			case INS_SBC: addWithCarry(cpu, ~busRead(cpu, addr)); break;
+			case INS_AND: setNZ(cpu, cpu->a &= busRead(cpu, addr)); break;
+			case INS_ORA: setNZ(cpu, cpu->a |= busRead(cpu, addr)); break;
+			case INS_EOR: setNZ(cpu, cpu->a ^= busRead(cpu, addr)); break;
+
+			case INS_ASL:
+			case INS_LSR:
+			case INS_ROL:
+			case INS_ROR:
+			val = acc ? cpu->a : busRead(cpu, addr);
+			c = cpu->p&FLAG_C;
+			if(op.instr == INS_ASL || op.instr == INS_ROL){
+				cpu->p = (cpu->p & ~FLAG_C) | val>>7;
+				val = val<<1 | (op.instr == INS_ROL ? c : 0);
+			} else{
+				cpu->p = (cpu->p & ~FLAG_C) | (val&1);
+				val = val>>1 | (op.instr == INS_ROR ? c<<7 : 0);
+			}
+			setNZ(cpu, val);
+			if(acc) cpu->a = val;
+			else busWrite(cpu, addr, val);
+			break;
+
+			case INS_BCC: taken = !(cpu->p&FLAG_C); break;
+			case INS_BCS: taken = cpu->p&FLAG_C; break;
+			case INS_BNE: taken = !(cpu->p&FLAG_Z); break;
+			case INS_BEQ: taken = cpu->p&FLAG_Z; break;
+			case INS_BPL: taken = !(cpu->p&FLAG_N); break;
+			case INS_BMI: taken = cpu->p&FLAG_N; break;
+			case INS_BVC: taken = !(cpu->p&FLAG_V); break;
+			case INS_BVS: taken = cpu->p&FLAG_V; break;
+
+			case INS_BIT:
+			val = busRead(cpu, addr);
+			cpu->p = (cpu->p & ~(FLAG_N|FLAG_V|FLAG_Z)) | (val&(FLAG_N|FLAG_V)) | ((cpu->a&val) ? 0 : FLAG_Z);
+			break;
+
+			case INS_BRK:
+			cpu->pc = pc + 2;
+			interrupt(cpu, 0xfffe, 1);
+			next = cpu->pc;
+			break;
+
+			case INS_CLC: cpu->p &= ~FLAG_C; break;
+			case INS_CLD: cpu->p &= ~FLAG_D; break;
+			case INS_CLI: cpu->p &= ~FLAG_I; break;
+			case INS_CLV: cpu->p &= ~FLAG_V; break;
+			case INS_SEC: cpu->p |= FLAG_C; break;
+			case INS_SED: cpu->p |= FLAG_D; break;
+			case INS_SEI: cpu->p |= FLAG_I; break;
+
+			case INS_CMP: compare(cpu, cpu->a, busRead(cpu, addr)); break;
+			case INS_CPX: compare(cpu, cpu->x, busRead(cpu, addr)); break;
+			case INS_CPY: compare(cpu, cpu->y, busRead(cpu, addr)); break;
+
+			case INS_DEC: busWrite(cpu, addr, setNZ(cpu, busRead(cpu, addr) - 1)); break;
+			case INS_INC: busWrite(cpu, addr, setNZ(cpu, busRead(cpu, addr) + 1)); break;
+			case INS_DEX: setNZ(cpu, --cpu->x); break;
+			case INS_DEY: setNZ(cpu, --cpu->y); break;
+			case INS_INX: setNZ(cpu, ++cpu->x); break;
+			case INS_INY: setNZ(cpu, ++cpu->y); break;
+
+			case INS_JMP:
+			if(addr == pc){
+				// An idle loop only ends on NMI; skip ahead to it if one is coming
+				if(!cpu->nmiEnabled) return STOP_IDLE;
+				if(cpu->cycles < nextNmi) cpu->cycles = nextNmi;
+			}
+			next = addr;
+			break;
+
+			case INS_JSR:
+			push(cpu, (next-1)>>8);
+			push(cpu, (next-1)&0xff);
+			next = addr;
+			break;
+
+			case INS_RTS:
+			next = pull(cpu);
+			next = (next | pull(cpu)<<8) + 1;
+			break;
+
+			case INS_RTI:
+			cpu->p = (pull(cpu) & ~FLAG_B) | FLAG_U;
+			next = pull(cpu);
+			next |= pull(cpu)<<8;
+			break;
+
+			case INS_LDA: setNZ(cpu, cpu->a = busRead(cpu, addr)); break;
+			case INS_LDX: setNZ(cpu, cpu->x = busRead(cpu, addr)); break;
+			case INS_LDY: setNZ(cpu, cpu->y = busRead(cpu, addr)); break;
+			case INS_STA: busWrite(cpu, addr, cpu->a); break;
+			case INS_STX: busWrite(cpu, addr, cpu->x); break;
+			case INS_STY: busWrite(cpu, addr, cpu->y); break;
+
+			case INS_NOP: break;
+
+			case INS_PHA: push(cpu, cpu->a); break;
+			case INS_PHP: push(cpu, cpu->p | FLAG_B | FLAG_U); break;
+			case INS_PLA: setNZ(cpu, cpu->a = pull(cpu)); break;
+			case INS_PLP: cpu->p = (pull(cpu) & ~FLAG_B) | FLAG_U; break;
+
+			case INS_TAX: setNZ(cpu, cpu->x = cpu->a); break;
+			case INS_TAY: setNZ(cpu, cpu->y = cpu->a); break;
+			case INS_TSX: setNZ(cpu, cpu->x = cpu->s); break;
+			case INS_TXA: setNZ(cpu, cpu->a = cpu->x); break;
+			case INS_TXS: cpu->s = cpu->x; break;
+			case INS_TYA: setNZ(cpu, cpu->a = cpu->y); break;
+		}
+		if(taken){
+			cpu->cycles += BRANCH_TAKEN_CYCLES + page_crossed(next, addr);
+			next = addr;
+		}
+		cpu->pc = next;
+		cpu->steps++;
+	}
+	return STOP_LIMIT;
+}
@@ -0,0 +1,45 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_CPU_H
+#define FC_CPU_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define CPU_MAX_WRITES 256
+
+typedef enum cpuStop{
+	STOP_LIMIT,    // Ran out of cycles
+	STOP_IDLE,     // Reached a JMP-to-self loop
+	STOP_INVALID,  // Hit an invalid opcode
+	STOP_BAD_FETCH // Fetched outside of RAM or PRG-ROM
+} cpuStop;
+
+typedef struct{
+	uint64_t cycle;
+	uint16_t pc;   // Address of the writing instruction
+	uint16_t addr;
+	uint8_t  val;
+} MapperWrite;
+
+typedef struct{
+	uint8_t  a, x, y, s, p;
+	uint16_t pc;
+	uint64_t steps;
+	uint64_t cycles;
+	uint8_t  nmiEnabled;
+	uint8_t  ppuStatus;
+	uint8_t  ram[0x800];
+	uint8_t  prgRam[0x2000];
+	int      writeCount;
+	MapperWrite writes[CPU_MAX_WRITES];
+} Cpu;
+
+void cpuReset(Cpu *cpu);
+cpuStop cpuRun(Cpu *cpu, uint64_t maxCycles);
+
+#endif
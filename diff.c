@@ -0,0 +1,546 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "chr.h"
+#include "diff.h"
+#include "names.h"
+#include "watch.h"
+
+// ROM diff: headers are compared field by field and banks by hash, so an identical
+//  bank costs one hash per side and only differing regions are walked byte by byte.
+// Patches are coalesced: IPS records absorb short unchanged gaps and long runs become
+//  RLE records; BPS reads unchanged source bytes in place, copies blocks that moved,
+//  and turns runs into copies of the previous target byte.
+
+#define PRG_BANK   (16*1024)
+#define CHR_BANK   (8*1024)
+#define SKIP_CHUNK 64 // Unchanged bytes are skipped this many at a time
+
+#define IPS_MAX_SIZE   0x1000000 // Offsets are 24-bit
+#define IPS_EOF        0x454f46  // "EOF": no record may start here
+#define IPS_MAX_RECORD 0xfffe    // One short of the 16-bit limit, for the EOF shift
+#define IPS_GAP        5         // Unchanged bytes cheaper to carry than a record header
+#define IPS_RLE_EDGE   9         // Run that pays for an 8-byte RLE record at a region edge...
+#define IPS_RLE_MIDDLE 14        // ...or mid-region, where it also splits the literal
+
+#define BPS_MIN_READ 3  // Unchanged bytes worth a SourceRead
+#define BPS_MIN_RUN  6  // Repeated bytes worth a TargetCopy
+#define BPS_MIN_COPY 8  // Moved bytes worth a SourceCopy
+#define BPS_BLOCK    32 // Moved blocks are found by hashing BPS_BLOCK bytes...
+#define BPS_STRIDE   16 // ...at every BPS_STRIDE bytes of the source
+
+enum _bps_actions{
+	BPS_SOURCE_READ,
+	BPS_TARGET_READ,
+	BPS_SOURCE_COPY,
+	BPS_TARGET_COPY
+};
+
+typedef struct{
+	uint8_t   *data;
+	size_t    len;
+	int       isINes;
+	RomLayout layout;
+} DiffRom;
+
+typedef struct{
+	FILE     *fp;
+	uint32_t crc; // Of everything written so far, for the BPS footer
+	size_t   len;
+} PatchOut;
+
+typedef struct{
+	PatchOut      *out;
+	const uint8_t *a, *b;
+	size_t        aLen, bLen;
+	int64_t       srcRel, tgtRel; // Relative offsets of the last copies
+	size_t        litStart, litLen;
+	int           actions;
+
+	// Source blocks by hash, built on the first literal byte
+	uint64_t      *keys;
+	uint32_t      *slots; // Block index + 1, 0 if empty
+	size_t        mask;
+	int           indexed;
+
+	// Moved block found at or ahead of the current target position
+	size_t        checked; // Target positions below this were already looked up
+	size_t        moveAt, moveFrom, moveLen;
+} BpsWriter;
+
+static uint8_t readDiffRom(const char *path, DiffRom *r){
+	FILE *fp = fopen(path, "rb");
+	if(fp == NULL) return 1;
+	fseek(fp, 0, SEEK_END);
+	long len = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	r->len = len > 0 ? len : 0;
+	r->data = malloc(r->len ? r->len : 1);
+	uint8_t err = !r->data || (r->len && fread(r->data, r->len, 1, fp) != 1);
+	fclose(fp);
+	if(err) return 1;
+
+	r->isINes = r->len >= 16 && !memcmp(r->data, "NES\x1a", 4);
+	if(r->isINes) decodeINesHeader(r->data, &r->layout);
+	return 0;
+}
+
+// Return how many leading bytes of a and b are equal, up to n
+static size_t matchLen(const uint8_t *a, const uint8_t *b, size_t n){
+	size_t i = 0;
+	while(i+SKIP_CHUNK <= n && !memcmp(a+i, b+i, SKIP_CHUNK)) i += SKIP_CHUNK;
+	while(i < n && a[i] == b[i]) i++;
+	return i;
+}
+
+static int diffField(const char *name, long a, long b){
+	if(a == b) return 0;
+	printf("  %s: %ld -> %ld\n", name, a, b);
+	return 1;
+}
+
+static int diffName(const char *name, const char *a, const char *b){
+	if(!strcmp(a, b)) return 0;
+	printf("  %s: %s -> %s\n", name, a, b);
+	return 1;
+}
+
+static const char *mirroringName(const uint8_t *h){
+	return (h[6]&0x08) ? "none" : (h[6]&0x01) ? "vertical" : "horizontal";
+}
+
+static const char *systemName(const uint8_t *h, int isNes2){
+	if((h[7]&0x3) < 3) return systemNames[h[7]&0x3];
+	return isNes2 ? systemNames[h[13]&0x0f] : "Other";
+}
+
+static long ramSize(int shift){
+	return shift ? 64L << shift : 0;
+}
+
+static void diffHeaders(const DiffRom *a, const DiffRom *b){
+	const uint8_t *ha = a->data, *hb = b->data;
+	const RomLayout *la = &a->layout, *lb = &b->layout;
+	int changed = 0;
+
+	printf(" Header:\n");
+	changed += diffName("Format", la->isNes2 ? "NES 2.0" : "iNES", lb->isNes2 ? "NES 2.0" : "iNES");
+	changed += diffField("PRG-ROM size (KiB)", la->prgSize*16, lb->prgSize*16);
+	changed += diffField("CHR-ROM size (KiB)", la->chrSize*8, lb->chrSize*8);
+	changed += diffField("Mapper", la->mapper, lb->mapper);
+	changed += diffName("Battery-backed", (ha[6]&0x02) ? "yes" : "no", (hb[6]&0x02) ? "yes" : "no");
+	changed += diffName("Mirroring", mirroringName(ha), mirroringName(hb));
+	changed += diffName("Trainer", la->hasTrainer ? "yes" : "no", lb->hasTrainer ? "yes" : "no");
+	changed += diffName("System", systemName(ha, la->isNes2), systemName(hb, lb->isNes2));
+
+	if(la->isNes2 && lb->isNes2){
+		changed += diffField("Submapper", ha[8]>>4, hb[8]>>4);
+		changed += diffField("PRG-RAM size (B)", ramSize(ha[10]&0x0f), ramSize(hb[10]&0x0f));
+		changed += diffField("PRG-NVRAM size (B)", ramSize(ha[10]>>4), ramSize(hb[10]>>4));
+		changed += diffField("CHR-RAM size (B)", ramSize(ha[11]&0x0f), ramSize(hb[11]&0x0f));
+		changed += diffField("CHR-NVRAM size (B)", ramSize(ha[11]>>4), ramSize(hb[11]>>4));
+		changed += diffName("Frame timing", regionNames[ha[12]&0x3], regionNames[hb[12]&0x3]);
+		changed += diffField("Misc ROMs", ha[14]&0x3, hb[14]&0x3);
+		changed += diffField("Input device", ha[15]&0x3f, hb[15]&0x3f);
+	}
+
+	if(!changed) printf(memcmp(ha, hb, 16) ? "  Only undecoded bytes differ\n" : "  Identical\n");
+	printf("\n");
+}
+
+// Compare one area of both ROMs bank by bank, hashing first so identical banks are
+//  never walked; banks past the end of a truncated file are left out
+static void diffBanks(
+	const char *name, const DiffRom *a, const DiffRom *b,
+	size_t startA, size_t startB, int64_t banksA, int64_t banksB, size_t bankLen
+){
+	int64_t availA = a->len > startA ? (int64_t)((a->len-startA)/bankLen) : 0;
+	int64_t availB = b->len > startB ? (int64_t)((b->len-startB)/bankLen) : 0;
+	if(banksA > availA) banksA = availA;
+	if(banksB > availB) banksB = availB;
+	if(!banksA && !banksB) return;
+
+	int64_t common = banksA < banksB ? banksA : banksB;
+	int64_t differ = 0;
+	printf(" %s (%zu KiB banks):\n", name, bankLen/1024);
+	for(int64_t i=0;i<common;i++){
+		const uint8_t *pa = a->data + startA + i*bankLen;
+		const uint8_t *pb = b->data + startB + i*bankLen;
+		if(hashBlock(pa, bankLen) == hashBlock(pb, bankLen)) continue;
+
+		size_t bytes = 0, runs = 0, first = 0, last = 0;
+		for(size_t j=0;j<bankLen;){
+			j += matchLen(pa+j, pb+j, bankLen-j);
+			if(j == bankLen) break;
+			size_t end = j;
+			while(end < bankLen && pa[end] != pb[end]) end++;
+			if(!runs) first = j;
+			last = end-1;
+			bytes += end-j;
+			runs++;
+			j = end;
+		}
+		printf(
+			"  Bank %ld: %zu byte%s differ%s in %zu run%s (0x%04zx-0x%04zx)\n",
+			i, bytes, bytes == 1 ? "" : "s", bytes == 1 ? "s" : "", runs, runs == 1 ? "" : "s", first, last
+		);
+		differ++;
+	}
+	for(int64_t i=common;i<banksB;i++) printf("  Bank %ld: added\n", i);
+	for(int64_t i=common;i<banksA;i++) printf("  Bank %ld: removed\n", i);
+	printf("  %ld of %ld common banks identical\n\n", common-differ, common);
+}
+
+static void putBytes(PatchOut *out, const void *data, size_t len){
+	if(!len) return;
+	fwrite(data, len, 1, out->fp);
+	out->crc = crc32(out->crc, data, len);
+	out->len += len;
+}
+
+static void putLe32(PatchOut *out, uint32_t v){
+	uint8_t buf[4] = {v, v>>8, v>>16, v>>24};
+	putBytes(out, buf, 4);
+}
+
+static void putIpsRecord(PatchOut *out, const uint8_t *b, size_t off, size_t len, int rle){
+	uint8_t hdr[8];
+
+	// A record at "EOF" would end the patch; start it one byte earlier instead
+	if(off == IPS_EOF){
+		if(!rle){
+			off--;
+			len++;
+		} else{
+			putIpsRecord(out, b, off-1, 2, 0);
+			if(!--len) return;
+			off++;
+		}
+	}
+	hdr[0] = off>>16;
+	hdr[1] = off>>8;
+	hdr[2] = off;
+	if(rle){
+		hdr[3] = hdr[4] = 0;
+		hdr[5] = len>>8;
+		hdr[6] = len;
+		hdr[7] = b[off];
+		putBytes(out, hdr, 8);
+		return;
+	}
+	hdr[3] = len>>8;
+	hdr[4] = len;
+	putBytes(out, hdr, 5);
+	putBytes(out, b+off, len);
+}
+
+static int putIpsLiteral(PatchOut *out, const uint8_t *b, size_t start, size_t end){
+	int records = 0;
+	for(size_t k=start;k<end;k+=IPS_MAX_RECORD){
+		putIpsRecord(out, b, k, end-k < IPS_MAX_RECORD ? end-k : IPS_MAX_RECORD, 0);
+		records++;
+	}
+	return records;
+}
+
+// Write the changed region [start, end) of b, splitting runs out as RLE records
+static int putIpsRegion(PatchOut *out, const uint8_t *b, size_t start, size_t end){
+	size_t lit = start;
+	int records = 0;
+	for(size_t i=start;i<end;){
+		size_t run = 1;
+		while(i+run < end && b[i+run] == b[i]) run++;
+		if(run < ((i == start || i+run == end) ? IPS_RLE_EDGE : IPS_RLE_MIDDLE)){
+			i += run;
+			continue;
+		}
+		records += putIpsLiteral(out, b, lit, i);
+		for(size_t k=i;k<i+run;k+=IPS_MAX_RECORD){
+			putIpsRecord(out, b, k, i+run-k < IPS_MAX_RECORD ? i+run-k : IPS_MAX_RECORD, 1);
+			records++;
+		}
+		i += run;
+		lit = i;
+	}
+	return records + putIpsLiteral(out, b, lit, end);
+}
+
+// Return the number of records written
+static int writeIps(PatchOut *out, const DiffRom *a, const DiffRom *b){
+	size_t common = a->len < b->len ? a->len : b->len;
+	int records = 0;
+
+	putBytes(out, "PATCH", 5);
+	for(size_t pos=0;pos<b->len;){
+		if(pos < common) pos += matchLen(a->data+pos, b->data+pos, common-pos);
+		if(pos >= b->len) break;
+
+		// Extend the region until IPS_GAP unchanged bytes in a row
+		size_t last = pos;
+		for(size_t i=pos; i<b->len && i-last <= IPS_GAP; i++){
+			if(i >= common || a->data[i] != b->data[i]) last = i;
+		}
+		records += putIpsRegion(out, b->data, pos, last+1);
+		pos = last+1;
+	}
+	putBytes(out, "EOF", 3);
+
+	// Truncation extension (Lunar IPS, Flips) when the target is shorter
+	if(b->len < a->len){
+		uint8_t size[3] = {b->len>>16, b->len>>8, b->len};
+		putBytes(out, size, 3);
+	}
+	return records;
+}
+
+static void putBpsNumber(PatchOut *out, uint64_t n){
+	uint8_t buf[10];
+	int len = 0;
+	for(;;){
+		uint8_t x = n&0x7f;
+		n >>= 7;
+		if(!n){
+			buf[len++] = 0x80|x;
+			break;
+		}
+		buf[len++] = x;
+		n--;
+	}
+	putBytes(out, buf, len);
+}
+
+static void putBpsOffset(PatchOut *out, int64_t rel){
+	putBpsNumber(out, (uint64_t)(rel < 0 ? -rel : rel)<<1 | (rel < 0));
+}
+
+static void putBpsAction(BpsWriter *w, int action, size_t len){
+	putBpsNumber(w->out, (uint64_t)(len-1)<<2 | action);
+	w->actions++;
+}
+
+static void flushBpsLiteral(BpsWriter *w){
+	if(!w->litLen) return;
+	putBpsAction(w, BPS_TARGET_READ, w->litLen);
+	putBytes(w->out, w->b + w->litStart, w->litLen);
+	w->litLen = 0;
+}
+
+// Hash every BPS_STRIDE-aligned block of the source; the first of equal blocks wins
+//  so filler doesn't pile up in one probe chain
+static void indexSource(BpsWriter *w){
+	size_t blocks = w->aLen >= BPS_BLOCK ? (w->aLen-BPS_BLOCK)/BPS_STRIDE + 1 : 0;
+	size_t size = 1;
+	while(size < blocks*2) size <<= 1;
+
+	w->indexed = 1;
+	w->keys = malloc(size*sizeof(uint64_t));
+	w->slots = calloc(size, sizeof(uint32_t));
+	if(!blocks || !w->keys || !w->slots){
+		free(w->keys);
+		free(w->slots);
+		w->keys = NULL;
+		w->slots = NULL;
+		return;
+	}
+	w->mask = size-1;
+
+	for(size_t i=0;i<blocks;i++){
+		uint64_t h = hashBlock(w->a + i*BPS_STRIDE, BPS_BLOCK);
+		size_t s = h & w->mask;
+		while(w->slots[s] && w->keys[s] != h) s = (s+1) & w->mask;
+		if(w->slots[s]) continue;
+		w->keys[s] = h;
+		w->slots[s] = i+1;
+	}
+}
+
+// Return the source offset + 1 of a block equal to the target's at pos, or 0
+static size_t findSourceBlock(const BpsWriter *w, size_t pos){
+	uint64_t h = hashBlock(w->b + pos, BPS_BLOCK);
+	for(size_t s=h&w->mask; w->slots[s]; s=(s+1)&w->mask){
+		if(w->keys[s] != h) continue;
+		size_t off = (size_t)(w->slots[s]-1)*BPS_STRIDE;
+		return memcmp(w->a+off, w->b+pos, BPS_BLOCK) ? 0 : off+1;
+	}
+	return 0;
+}
+
+// Look for a moved block starting at pos; any shift lines up with an indexed source
+//  block within BPS_STRIDE target positions, and each position is looked up once
+static int findMove(BpsWriter *w, size_t pos){
+	if(!w->indexed) indexSource(w);
+	if(!w->keys) return 0;
+
+	// Drop the part of a pending move that other actions already covered
+	if(w->moveLen && w->moveAt < pos){
+		size_t skip = pos - w->moveAt;
+		w->moveLen = skip < w->moveLen ? w->moveLen-skip : 0;
+		w->moveFrom += skip;
+		w->moveAt = pos;
+	}
+	if(w->moveLen >= BPS_MIN_COPY) return w->moveAt == pos;
+
+	size_t p = w->checked > pos ? w->checked : pos;
+	for(; p < pos+BPS_STRIDE && p+BPS_BLOCK <= w->bLen; p++){
+		size_t off = findSourceBlock(w, p);
+		if(!off--) continue;
+
+		w->checked = p+1;
+		while(p > pos && off > 0 && w->a[off-1] == w->b[p-1]){
+			p--;
+			off--;
+		}
+		size_t room = w->aLen-off < w->bLen-p ? w->aLen-off : w->bLen-p;
+		w->moveAt = p;
+		w->moveFrom = off;
+		w->moveLen = matchLen(w->a+off, w->b+p, room);
+		return p == pos;
+	}
+	w->checked = p;
+	return 0;
+}
+
+// Return the number of actions written; moved blocks are skipped if the index won't fit
+static int writeBps(PatchOut *out, const DiffRom *a, const DiffRom *b){
+	BpsWriter w = {.out = out, .a = a->data, .b = b->data, .aLen = a->len, .bLen = b->len};
+	size_t common = a->len < b->len ? a->len : b->len;
+
+	putBytes(out, "BPS1", 4);
+	putBpsNumber(out, a->len);
+	putBpsNumber(out, b->len);
+	putBpsNumber(out, 0); // No metadata
+
+	for(size_t pos=0;pos<b->len;){
+		size_t same = pos < common ? matchLen(a->data+pos, b->data+pos, common-pos) : 0;
+		if(same >= BPS_MIN_READ){
+			flushBpsLiteral(&w);
+			putBpsAction(&w, BPS_SOURCE_READ, same);
+			pos += same;
+			continue;
+		}
+
+		size_t run = 1;
+		while(pos+run < b->len && b->data[pos+run] == b->data[pos]) run++;
+		if(run >= BPS_MIN_RUN){
+			// Copy the run from the target byte before it, writing its first byte if needed
+			if(!pos || b->data[pos-1] != b->data[pos]){
+				if(!w.litLen) w.litStart = pos;
+				w.litLen++;
+				pos++;
+				run--;
+			}
+			flushBpsLiteral(&w);
+			putBpsAction(&w, BPS_TARGET_COPY, run);
+			putBpsOffset(out, (int64_t)(pos-1) - w.tgtRel);
+			w.tgtRel = pos-1 + run;
+			pos += run;
+			continue;
+		}
+
+		if(findMove(&w, pos)){
+			flushBpsLiteral(&w);
+			putBpsAction(&w, BPS_SOURCE_COPY, w.moveLen);
+			putBpsOffset(out, (int64_t)w.moveFrom - w.srcRel);
+			w.srcRel = w.moveFrom + w.moveLen;
+			pos += w.moveLen;
+			w.moveLen = 0;
+			continue;
+		}
+
+		if(!w.litLen) w.litStart = pos;
+		w.litLen++;
+		pos++;
+	}
+	flushBpsLiteral(&w);
+	free(w.keys);
+	free(w.slots);
+
+	putLe32(out, crc32(0, a->data, a->len));
+	putLe32(out, crc32(0, b->data, b->len));
+	putLe32(out, out->crc);
+	return w.actions;
+}
+
+// Return 0 for IPS, 1 for BPS or -1 if the extension is neither
+static int patchFormat(const char *path){
+	const char *ext = strrchr(path, '.');
+	if(ext && !strcmp(ext, ".ips")) return 0;
+	if(ext && !strcmp(ext, ".bps")) return 1;
+	return -1;
+}
+
+static uint8_t writePatch(const char *path, const DiffRom *a, const DiffRom *b){
+	int bps = patchFormat(path);
+	FILE *fp = fopen(path, "wb");
+	if(fp == NULL){
+		perror("Error writing patch");
+		return 1;
+	}
+
+	PatchOut out = {fp, 0, 0};
+	int count = bps ? writeBps(&out, a, b) : writeIps(&out, a, b);
+	int err = ferror(fp);
+	if(fclose(fp) || err){
+		printf("Patch generation failed: could not write %s.\n", path);
+		return 1;
+	}
+	printf(
+		" Wrote %s: %s, %d %s, %zu bytes\n\n",
+		path, bps ? "BPS" : "IPS", count, bps ? "actions" : "records", out.len
+	);
+	return 0;
+}
+
+// Compare ROM A to ROM B and optionally write a patch from A to B, as IPS or BPS by
+//  the patch file's extension
+int diffRoms(const char *pathA, const char *pathB, const char *patchPath){
+	DiffRom a = {0}, b = {0};
+	int ret = 0;
+
+	if(patchPath && patchFormat(patchPath) < 0){
+		fprintf(stderr, "Unknown patch format: %s (use .ips or .bps)\n", patchPath);
+		return 1;
+	}
+	if(readDiffRom(pathA, &a) || readDiffRom(pathB, &b)){
+		perror("Error opening ROM");
+		free(a.data);
+		free(b.data);
+		return 1;
+	}
+
+	printf("Comparing %s -> %s:\n", pathA, pathB);
+	if(a.len == b.len && !memcmp(a.data, b.data, a.len)) printf(" Files are identical\n\n");
+	else if(a.isINes && b.isINes){
+		diffHeaders(&a, &b);
+		if(a.layout.hasTrainer && b.layout.hasTrainer && a.len >= 528 && b.len >= 528)
+			printf(" Trainer: %s\n\n", memcmp(a.data+16, b.data+16, 512) ? "differs" : "identical");
+
+		size_t prgA = 16 + (a.layout.hasTrainer ? 512 : 0), prgB = 16 + (b.layout.hasTrainer ? 512 : 0);
+		diffBanks("PRG-ROM", &a, &b, prgA, prgB, a.layout.prgSize, b.layout.prgSize, PRG_BANK);
+		diffBanks(
+			"CHR-ROM", &a, &b, prgA + a.layout.prgSize*PRG_BANK, prgB + b.layout.prgSize*PRG_BANK,
+			a.layout.chrSize, b.layout.chrSize, CHR_BANK
+		);
+	} else printf(" Not both iNES ROMs: comparing raw bytes only\n\n");
+	if(a.len != b.len) printf(" File size: %zu -> %zu bytes\n\n", a.len, b.len);
+
+	if(patchPath){
+		if(!patchFormat(patchPath) && b.len > IPS_MAX_SIZE){
+			fprintf(stderr, "%s is too large for IPS: use a .bps patch\n", pathB);
+			ret = 1;
+		} else ret = writePatch(patchPath, &a, &b);
+	}
+	free(a.data);
+	free(b.data);
+	return ret;
+}
@@ -0,0 +1,12 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_DIFF_H
+#define FC_DIFF_H
+
+int diffRoms(const char *pathA, const char *pathB, const char *patchPath);
+
+#endif
@@ -12,9 +12,9 @@
 #include "disasm.h"
 #include "instructions.h"
 
-// Get disassembly of instruction at addr;
+// Get disassembly of the instruction in bytes, located at addr;
 // Return address of the next instruction
-uint16_t disassemble(FILE *fp, uint16_t addr, char *out, uint16_t n){
+uint16_t disassembleBytes(const uint8_t *bytes, uint16_t addr, char *out, uint16_t n){
 	Opcode   op;
 	uint8_t  ins, param8  = 0;
 	uint16_t param16 = 0;
@@ -22,7 +22,7 @@ uint16_t disassemble(FILE *fp, uint16_t addr, char *out, uint16_t n){
 	char pbuf[10]; // Instruction parameters
 	char bbuf[11]; // Instruction hex dump
 
-	ins = (uint8_t)readMemory(fp, addr);
+	ins = bytes[0];
 	op = opcodes[ins];
 	nextAddr = addr + instruction_length[op.addr_mode];
 
@@ -32,12 +32,12 @@ uint16_t disassemble(FILE *fp, uint16_t addr, char *out, uint16_t n){
 		break;
 
 		case 2:
-		param8  = (uint8_t)readMemory(fp, 1 + addr);
+		param8  = bytes[1];
 		snprintf(bbuf, 11, "; %02X %02X", ins, param8);
 		break;
 		
 		case 3:
-		param16 = (uint8_t)readMemory(fp, 1 + addr) | (uint8_t)readMemory(fp, 2 + addr) << 8;
+		param16 = bytes[1] | bytes[2] << 8;
 		snprintf(bbuf, 11, "; %02X %02X %02X", ins, param16&0xff, param16>>8);
 		break;
 
@@ -104,4 +104,11 @@ uint16_t disassemble(FILE *fp, uint16_t addr, char *out, uint16_t n){
 	snprintf(out, n, "L%04X:\t%s\t%s\t%s", addr, mnemonics[op.instr], pbuf, bbuf);
 
 	return nextAddr;
-}
\ No newline at end of file
+}
+
+// Same as disassembleBytes(), reading the instruction at addr from the ROM file
+uint16_t disassemble(FILE *fp, uint16_t addr, char *out, uint16_t n){
+	uint8_t bytes[3];
+	for(int i=0;i<3;i++) bytes[i] = (uint8_t)readMemory(fp, addr+i);
+	return disassembleBytes(bytes, addr, out, n);
+}
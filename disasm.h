@@ -12,6 +12,7 @@
 
 #include "instructions.h"
 
+uint16_t disassembleBytes(const uint8_t *bytes, uint16_t addr, char *out, uint16_t n);
 uint16_t disassemble(FILE *fp, uint16_t addr, char *out, uint16_t n);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,307 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "filter.h"
+
+// --where expressions: C-like integer arithmetic, comparisons and logic over named
+//  ROM fields. The expression is parsed once into a tree, split at its top-level &&
+//  into predicates, and each predicate is compiled into the postfix program of the
+//  earliest stage that knows all of its fields.
+
+#define FILTER_MAX_NODES 256
+#define FILTER_MAX_DEPTH 64 // Nested unary operators and parentheses
+
+enum _filter_ops{
+	F_CONST,
+	F_FIELD,
+	F_NOT,
+	F_NEG,
+	F_OR,
+	F_AND,
+	F_EQ,
+	F_NE,
+	F_LT,
+	F_LE,
+	F_GT,
+	F_GE,
+	F_ADD,
+	F_SUB,
+	F_MUL,
+	F_DIV,
+	F_MOD
+};
+
+static const struct{
+	const char  *name;
+	filterStage stage;
+} fields[] = {
+	[FIELD_MAPPER]      = {"mapper",      STAGE_HEADER},
+	[FIELD_SUBMAPPER]   = {"submapper",   STAGE_HEADER},
+	[FIELD_PRG_KIB]     = {"prg_kib",     STAGE_HEADER},
+	[FIELD_CHR_KIB]     = {"chr_kib",     STAGE_HEADER},
+	[FIELD_NES2]        = {"nes2",        STAGE_HEADER},
+	[FIELD_TRAINER]     = {"trainer",     STAGE_HEADER},
+	[FIELD_BATTERY]     = {"battery",     STAGE_HEADER},
+	[FIELD_VERTICAL]    = {"vertical",    STAGE_HEADER},
+	[FIELD_FOUR_SCREEN] = {"four_screen", STAGE_HEADER},
+	[FIELD_FILE_SIZE]   = {"file_size",   STAGE_HEADER},
+	[FIELD_OFFICIAL]    = {"official",    STAGE_OFFICIAL},
+	[FIELD_FREE_PRG]    = {"free_prg",    STAGE_ANALYSIS},
+	[FIELD_FREE_CHR]    = {"free_chr",    STAGE_ANALYSIS}
+};
+
+typedef struct{
+	uint8_t op;
+	int64_t value;
+	int     left, right; // Operand nodes
+} Node;
+
+// Parser state; expressions are compiled once, before any worker starts
+static Node nodes[FILTER_MAX_NODES];
+static int nodeCount;
+static int depth;
+static const char *pos;
+static const char *error;
+
+static int parseOr();
+
+static int newNode(uint8_t op, int64_t value, int left, int right){
+	if(left < 0 || right < -1) return -1;
+	if(nodeCount == FILTER_MAX_NODES){
+		if(!error) error = "expression too long";
+		return -1;
+	}
+	nodes[nodeCount] = (Node){op, value, left, right};
+	return nodeCount++;
+}
+
+static void skipSpaces(){
+	while(isspace((unsigned char)*pos)) pos++;
+}
+
+static int accept(const char *tok){
+	skipSpaces();
+	size_t len = strlen(tok);
+	if(strncmp(pos, tok, len)) return 0;
+	pos += len;
+	return 1;
+}
+
+static int parsePrimary(){
+	skipSpaces();
+	if(isdigit((unsigned char)*pos)){
+		char *end;
+		int64_t value = strtoll(pos, &end, 0);
+		pos = end;
+		return newNode(F_CONST, value, 0, -1);
+	}
+	if(isalpha((unsigned char)*pos) || *pos == '_'){
+		const char *start = pos;
+		while(isalnum((unsigned char)*pos) || *pos == '_') pos++;
+		for(int f=0;f<FIELD_COUNT;f++){
+			if(strlen(fields[f].name) == (size_t)(pos-start) && !strncmp(fields[f].name, start, pos-start))
+				return newNode(F_FIELD, f, 0, -1);
+		}
+		pos = start;
+		if(!error) error = "unknown field";
+		return -1;
+	}
+	if(accept("(")){
+		int node = parseOr();
+		if(node >= 0 && !accept(")")){
+			if(!error) error = "expected ')'";
+			return -1;
+		}
+		return node;
+	}
+	if(!error) error = "expected a number, field or '('";
+	return -1;
+}
+
+// Every nested operator or parenthesis recurses through here, so bound the depth
+static int parseUnary(){
+	int node;
+	if(depth == FILTER_MAX_DEPTH){
+		if(!error) error = "expression nested too deeply";
+		return -1;
+	}
+	depth++;
+	if(accept("!")) node = newNode(F_NOT, 0, parseUnary(), -1);
+	else if(accept("-")) node = newNode(F_NEG, 0, parseUnary(), -1);
+	else node = parsePrimary();
+	depth--;
+	return node;
+}
+
+static int parseMultiplicative(){
+	int node = parseUnary();
+	for(;;){
+		if(accept("*")) node = newNode(F_MUL, 0, node, parseUnary());
+		else if(accept("/")) node = newNode(F_DIV, 0, node, parseUnary());
+		else if(accept("%")) node = newNode(F_MOD, 0, node, parseUnary());
+		else return node;
+	}
+}
+
+static int parseAdditive(){
+	int node = parseMultiplicative();
+	for(;;){
+		if(accept("+")) node = newNode(F_ADD, 0, node, parseMultiplicative());
+		else if(accept("-")) node = newNode(F_SUB, 0, node, parseMultiplicative());
+		else return node;
+	}
+}
+
+static int parseRelational(){
+	int node = parseAdditive();
+	for(;;){
+		if(accept("<=")) node = newNode(F_LE, 0, node, parseAdditive());
+		else if(accept(">=")) node = newNode(F_GE, 0, node, parseAdditive());
+		else if(accept("<")) node = newNode(F_LT, 0, node, parseAdditive());
+		else if(accept(">")) node = newNode(F_GT, 0, node, parseAdditive());
+		else return node;
+	}
+}
+
+static int parseEquality(){
+	int node = parseRelational();
+	for(;;){
+		if(accept("==")) node = newNode(F_EQ, 0, node, parseRelational());
+		else if(accept("!=")) node = newNode(F_NE, 0, node, parseRelational());
+		else return node;
+	}
+}
+
+static int parseAnd(){
+	int node = parseEquality();
+	while(accept("&&")) node = newNode(F_AND, 0, node, parseEquality());
+	return node;
+}
+
+static int parseOr(){
+	int node = parseAnd();
+	while(accept("||")) node = newNode(F_OR, 0, node, parseAnd());
+	return node;
+}
+
+static filterStage nodeStage(int n){
+	filterStage stage = nodes[n].op == F_FIELD ? fields[nodes[n].value].stage : STAGE_HEADER;
+	if(nodes[n].op == F_CONST || nodes[n].op == F_FIELD) return stage;
+	filterStage left = nodeStage(nodes[n].left);
+	if(left > stage) stage = left;
+	if(nodes[n].right >= 0){
+		filterStage right = nodeStage(nodes[n].right);
+		if(right > stage) stage = right;
+	}
+	return stage;
+}
+
+static uint8_t emit(FilterProgram *out, filterStage stage, uint8_t op, int64_t arg){
+	if(out->len[stage] == FILTER_MAX_CODE) return 1;
+	out->code[stage][out->len[stage]++] = (FilterInstr){op, arg};
+	return 0;
+}
+
+static uint8_t compileNode(FilterProgram *out, filterStage stage, int n){
+	const Node *node = &nodes[n];
+	if(node->op == F_CONST || node->op == F_FIELD) return emit(out, stage, node->op, node->value);
+	if(compileNode(out, stage, node->left)) return 1;
+	if(node->right >= 0 && compileNode(out, stage, node->right)) return 1;
+	return emit(out, stage, node->op, 0);
+}
+
+// Give every top-level && operand to the program of its own stage
+static uint8_t pushDown(FilterProgram *out, int n){
+	if(nodes[n].op == F_AND) return pushDown(out, nodes[n].left) || pushDown(out, nodes[n].right);
+
+	filterStage stage = nodeStage(n);
+	int first = !out->len[stage];
+	if(compileNode(out, stage, n)) return 1;
+	return first ? 0 : emit(out, stage, F_AND, 0);
+}
+
+// Compile expr into per-stage programs; print the error and return 1 if it's invalid
+uint8_t compileFilter(const char *expr, FilterProgram *out){
+	memset(out->len, 0, sizeof(out->len));
+	nodeCount = depth = 0;
+	error = NULL;
+	pos = expr;
+
+	int root = parseOr();
+	skipSpaces();
+	if(root >= 0 && *pos) error = "unexpected text";
+	if(root < 0 || error){
+		fprintf(stderr, "Invalid --where expression, %s at: %s\n", error ? error : "syntax error", *pos ? pos : "(end)");
+		return 1;
+	}
+	if(pushDown(out, root)){
+		fprintf(stderr, "Invalid --where expression, expression too long\n");
+		return 1;
+	}
+	return 0;
+}
+
+// Fill the fields known from the header alone
+void filterHeaderValues(const uint8_t *header, int64_t fileSize, int64_t *values){
+	RomLayout rom;
+	decodeINesHeader(header, &rom);
+	values[FIELD_MAPPER] = rom.mapper;
+	values[FIELD_SUBMAPPER] = rom.isNes2 ? header[8]>>4 : 0;
+	values[FIELD_PRG_KIB] = rom.prgSize*16;
+	values[FIELD_CHR_KIB] = rom.chrSize*8;
+	values[FIELD_NES2] = rom.isNes2;
+	values[FIELD_TRAINER] = !!rom.hasTrainer;
+	values[FIELD_BATTERY] = !!(header[6]&0x02);
+	values[FIELD_VERTICAL] = header[6]&0x01;
+	values[FIELD_FOUR_SCREEN] = !!(header[6]&0x08);
+	values[FIELD_FILE_SIZE] = fileSize;
+}
+
+// Return whether the predicates of a stage hold (always true if it has none)
+int runFilter(const FilterProgram *prog, filterStage stage, const int64_t *values){
+	int64_t stack[FILTER_MAX_CODE];
+	int sp = 0;
+
+	for(int i=0;i<prog->len[stage];i++){
+		const FilterInstr *in = &prog->code[stage][i];
+		int64_t a, b;
+		switch(in->op){
+			case F_CONST: stack[sp++] = in->arg; continue;
+			case F_FIELD: stack[sp++] = values[in->arg]; continue;
+			case F_NOT:   stack[sp-1] = !stack[sp-1]; continue;
+			case F_NEG:   stack[sp-1] = -(uint64_t)stack[sp-1]; continue;
+		}
+		b = stack[--sp];
+		a = stack[sp-1];
+		switch(in->op){
+			case F_OR:  a = a || b; break;
+			case F_AND: a = a && b; break;
+			case F_EQ:  a = a == b; break;
+			case F_NE:  a = a != b; break;
+			case F_LT:  a = a < b; break;
+			case F_LE:  a = a <= b; break;
+			case F_GT:  a = a > b; break;
+			case F_GE:  a = a >= b; break;
+			// Arithmetic wraps around instead of overflowing
+			case F_ADD: a = (uint64_t)a + b; break;
+			case F_SUB: a = (uint64_t)a - b; break;
+			case F_MUL: a = (uint64_t)a * b; break;
+			// Division by zero gives 0 rather than a crash mid-scan, and INT64_MIN / -1
+			//  wraps like the other operators
+			case F_DIV: a = !b ? 0 : b == -1 ? (int64_t)-(uint64_t)a : a/b; break;
+			case F_MOD: a = !b || b == -1 ? 0 : a%b; break;
+		}
+		stack[sp-1] = a;
+	}
+	return !sp || stack[0];
+}
@@ -0,0 +1,55 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_FILTER_H
+#define FC_FILTER_H
+
+#include <stdint.h>
+
+#define FILTER_MAX_CODE 256 // Instructions per stage
+
+// When a field becomes known while scanning a file; predicates run at the earliest
+//  stage that has all their fields
+typedef enum filterStage{
+	STAGE_HEADER,   // 16-byte header and file size
+	STAGE_OFFICIAL, // 26 bytes at the end of PRG-ROM
+	STAGE_ANALYSIS, // Whole file read and measured
+	STAGE_COUNT
+} filterStage;
+
+typedef enum filterField{
+	FIELD_MAPPER,
+	FIELD_SUBMAPPER,
+	FIELD_PRG_KIB,
+	FIELD_CHR_KIB,
+	FIELD_NES2,
+	FIELD_TRAINER,
+	FIELD_BATTERY,
+	FIELD_VERTICAL,
+	FIELD_FOUR_SCREEN,
+	FIELD_FILE_SIZE,
+	FIELD_OFFICIAL,
+	FIELD_FREE_PRG,
+	FIELD_FREE_CHR,
+	FIELD_COUNT
+} filterField;
+
+typedef struct{
+	uint8_t op;
+	int64_t arg; // Constant or field
+} FilterInstr;
+
+// One postfix program per stage, each the AND of the predicates that run there
+typedef struct{
+	FilterInstr code[STAGE_COUNT][FILTER_MAX_CODE];
+	int         len[STAGE_COUNT];
+} FilterProgram;
+
+uint8_t compileFilter(const char *expr, FilterProgram *out);
+void filterHeaderValues(const uint8_t *header, int64_t fileSize, int64_t *values);
+int runFilter(const FilterProgram *prog, filterStage stage, const int64_t *values);
+
+#endif
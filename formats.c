@@ -0,0 +1,417 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#define _GNU_SOURCE // fmemopen()
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "formats.h"
+#include "names.h"
+
+// Every analysis reads an iNES layout, so other containers are converted on open:
+//  their chunk/file tables are walked with seeks, without reading any payload, and
+//  then each PRG/CHR payload is read once, straight into its place in an iNES image
+//  that is handed out as a memory stream. iNES files are used as they are.
+
+int romFormat;
+const char *const romFormatNames[] = {"iNES", "UNIF", "FDS", "NSF"};
+
+static uint8_t *image; // Backing buffer of the converted stream
+static size_t imageSize;
+
+// https://www.nesdev.org/wiki/UNIF
+typedef struct{
+	uint32_t offset, len;
+} Chunk;
+
+static Chunk unifPrg[16], unifChr[16];
+static char unifBoard[64];
+static uint32_t unifRevision;
+static int unifMapper, unifMirroring, unifBattery;
+
+static const struct{
+	const char *board;
+	int        mapper;
+} unifBoards[] = {
+	{"NROM", 0}, {"NROM-128", 0}, {"NROM-256", 0},
+	{"SAROM", 1}, {"SBROM", 1}, {"SCROM", 1}, {"SEROM", 1}, {"SFROM", 1}, {"SGROM", 1},
+	{"SHROM", 1}, {"SJROM", 1}, {"SKROM", 1}, {"SLROM", 1}, {"SL1ROM", 1}, {"SNROM", 1},
+	{"SOROM", 1}, {"SUROM", 1}, {"SXROM", 1},
+	{"UNROM", 2}, {"UOROM", 2},
+	{"CNROM", 3},
+	{"TBROM", 4}, {"TEROM", 4}, {"TFROM", 4}, {"TGROM", 4}, {"TKROM", 4}, {"TLROM", 4},
+	{"TNROM", 4}, {"TR1ROM", 4}, {"TSROM", 4}, {"TVROM", 4},
+	{"EKROM", 5}, {"ELROM", 5}, {"ETROM", 5}, {"EWROM", 5},
+	{"AMROM", 7}, {"ANROM", 7}, {"AOROM", 7},
+	{"PEEOROM", 9}, {"PNROM", 9},
+	{"FJROM", 10}, {"FKROM", 10},
+	{"CPROM", 13},
+	{"BNROM", 34},
+	{"GNROM", 66}, {"MHROM", 66},
+	{"JLROM", 69}, {"JSROM", 69},
+	{"TKSROM", 118}, {"TLSROM", 118},
+	{"TQROM", 119}
+};
+
+// https://www.nesdev.org/wiki/FDS_disk_format
+typedef struct{
+	uint8_t  side, number, id, type;
+	uint8_t  hidden; // Past the count in the file amount block
+	char     name[9];
+	uint16_t addr, size;
+	uint32_t offset; // Payload offset in the file
+} FdsFile;
+
+static FdsFile fdsFiles[FDS_MAX_FILES];
+static int fdsFileCount, fdsSides, fdsBootId;
+static char fdsGameCode[4];
+
+// https://www.nesdev.org/wiki/NSF
+static uint8_t nsfHeader[128];
+static uint32_t nsfDataLen;
+
+static uint16_t le16(const uint8_t *p){
+	return p[0] | p[1]<<8;
+}
+
+static uint32_t le32(const uint8_t *p){
+	return p[0] | p[1]<<8 | p[2]<<16 | (uint32_t)p[3]<<24;
+}
+
+static long fileSize(FILE *rom){
+	fseek(rom, 0, SEEK_END);
+	long size = ftell(rom);
+	fseek(rom, 0, SEEK_SET);
+	return size;
+}
+
+// Allocate the iNES image and fill in its header; return the start of PRG-ROM
+static uint8_t *newImage(int prgBanks, int chrBanks, int mapperNo, uint8_t flags6){
+	if(prgBanks < 1 || prgBanks > 255 || chrBanks > 255) return NULL;
+	imageSize = 16 + prgBanks*16*1024 + chrBanks*8*1024;
+	image = calloc(imageSize, 1);
+	if(!image) return NULL;
+
+	memcpy(image, "NES\x1a", 4);
+	image[4] = prgBanks;
+	image[5] = chrBanks;
+	image[6] = (mapperNo&0x0f)<<4 | flags6;
+	image[7] = mapperNo&0xf0;
+	return image+16;
+}
+
+// Read len bytes at offset in the file into dst
+static uint8_t readAt(FILE *rom, uint32_t offset, uint8_t *dst, uint32_t len){
+	if(!len) return 0;
+	fseek(rom, offset, SEEK_SET);
+	return fread(dst, len, 1, rom) != 1;
+}
+
+static int lookupBoard(const char *board){
+	// Drop the manufacturer prefix ("NES-", "HVC-", "UNL-"...)
+	const char *dash = strchr(board, '-');
+	const char *name = (dash && dash-board == 3) ? dash+1 : board;
+
+	for(size_t i=0;i<sizeof(unifBoards)/sizeof(unifBoards[0]);i++){
+		if(!strcmp(name, unifBoards[i].board)) return unifBoards[i].mapper;
+	}
+	return -1;
+}
+
+static int hexDigit(uint8_t c){
+	if(c >= '0' && c <= '9') return c-'0';
+	if(c >= 'A' && c <= 'F') return c-'A'+10;
+	return -1;
+}
+
+static uint8_t readUnif(FILE *rom){
+	uint8_t header[32], chunk[8];
+	uint32_t prgLen = 0, chrLen = 0;
+	long size = fileSize(rom);
+
+	memset(unifPrg, 0, sizeof(unifPrg));
+	memset(unifChr, 0, sizeof(unifChr));
+	memset(unifBoard, 0, sizeof(unifBoard));
+	unifMirroring = -1;
+	unifBattery = 0;
+	if(fread(header, 32, 1, rom) != 1) return 1;
+	unifRevision = le32(header+4);
+
+	// Index the chunks; only the small ones are read
+	for(long pos=32; pos+8 <= size;){
+		fseek(rom, pos, SEEK_SET);
+		if(fread(chunk, 8, 1, rom) != 1) return 1;
+		uint32_t len = le32(chunk+4);
+		if(len > (uint32_t)(size-pos-8)) return 1;
+
+		int n = hexDigit(chunk[3]);
+		if(!memcmp(chunk, "PRG", 3) && n >= 0) unifPrg[n] = (Chunk){pos+8, len};
+		else if(!memcmp(chunk, "CHR", 3) && n >= 0) unifChr[n] = (Chunk){pos+8, len};
+		else if(!memcmp(chunk, "MAPR", 4)) fread(unifBoard, len < 63 ? len : 63, 1, rom);
+		else if(!memcmp(chunk, "MIRR", 4) && len) unifMirroring = fgetc(rom);
+		else if(!memcmp(chunk, "BATR", 4) && len) unifBattery = fgetc(rom) > 0;
+		pos += 8+len;
+	}
+	for(int i=0;i<16;i++){
+		prgLen += unifPrg[i].len;
+		chrLen += unifChr[i].len;
+	}
+	if(!prgLen) return 1;
+
+	unifMapper = lookupBoard(unifBoard);
+	int prgBanks = (prgLen + 16*1024-1) / (16*1024);
+	int chrBanks = (chrLen + 8*1024-1) / (8*1024);
+	uint8_t flags6 =
+		(unifMirroring == 1 ? 0x01 : 0) |
+		(unifMirroring == 4 ? 0x08 : 0) |
+		(unifBattery ? 0x02 : 0);
+	uint8_t *prg = newImage(prgBanks, chrBanks, unifMapper < 0 ? 0 : unifMapper, flags6);
+	if(!prg) return 1;
+
+	// PRG0-PRGF and CHR0-CHRF are concatenated in order, whatever the order in the file
+	uint8_t *chr = prg + prgBanks*16*1024;
+	for(int i=0;i<16;i++){
+		if(readAt(rom, unifPrg[i].offset, prg, unifPrg[i].len)) return 1;
+		if(readAt(rom, unifChr[i].offset, chr, unifChr[i].len)) return 1;
+		prg += unifPrg[i].len;
+		chr += unifChr[i].len;
+	}
+	// An 8 KiB PRG (some NROM boards) is mirrored in the 16 KiB bank
+	for(uint32_t i=prgLen;i<(uint32_t)prgBanks*16*1024;i++) image[16+i] = image[16 + i%prgLen];
+	return 0;
+}
+
+static uint8_t readFds(FILE *rom){
+	uint8_t block[56];
+	long size = fileSize(rom);
+	long base = 0;
+
+	if(fread(block, 16, 1, rom) != 1) return 1;
+	if(!memcmp(block, "FDS\x1a", 4)) base = 16; // fwNES header
+	fdsSides = (size-base + FDS_SIDE_SIZE-1) / FDS_SIDE_SIZE;
+	fdsFileCount = 0;
+
+	// Walk the file table of every side
+	for(int side=0;side<fdsSides;side++){
+		long pos = base + side*FDS_SIDE_SIZE;
+		long end = pos+FDS_SIDE_SIZE < size ? pos+FDS_SIDE_SIZE : size;
+
+		// Disk info block, then file amount block
+		if(end-pos < 58 || readAt(rom, pos, block, 56) || block[0] != 1 || memcmp(block+1, "*NINTENDO-HVC*", 14)){
+			if(!side) return 1;
+			fdsSides = side;
+			break;
+		}
+		if(!side){
+			memcpy(fdsGameCode, block+16, 3);
+			fdsGameCode[3] = 0;
+			fdsBootId = block[25];
+		}
+		if(readAt(rom, pos+56, block, 2) || block[0] != 2) continue;
+		int declared = block[1];
+		pos += 58;
+
+		// File header blocks, each followed by its data block
+		for(int n=0; pos+17 <= end && fdsFileCount < FDS_MAX_FILES; n++){
+			if(readAt(rom, pos, block, 17) || block[0] != 3 || block[16] != 4) break;
+			FdsFile *f = &fdsFiles[fdsFileCount];
+			f->side = side;
+			f->hidden = n >= declared;
+			f->number = block[1];
+			f->id = block[2];
+			memcpy(f->name, block+3, 8);
+			f->name[8] = 0;
+			for(int k=0;k<8;k++) if(f->name[k] < 0x20 || f->name[k] > 0x7e) f->name[k] = '.';
+			f->addr = le16(block+11);
+			f->size = le16(block+13);
+			f->type = block[15];
+			f->offset = pos+17;
+			if(f->offset + f->size > end) break;
+			pos = f->offset + f->size;
+			fdsFileCount++;
+		}
+	}
+
+	// The image is what the BIOS boots: side A files up to the boot ID, with PRG
+	//  files at $8000-$DFFF (the $6000-$7FFF part of RAM isn't in the view) and CHR
+	//  files in CHR-RAM
+	int chrBanks = 0;
+	for(int i=0;i<fdsFileCount;i++){
+		if(!fdsFiles[i].side && fdsFiles[i].id <= fdsBootId && fdsFiles[i].type == 1) chrBanks = 1;
+	}
+	uint8_t *prg = newImage(2, chrBanks, 20, 0);
+	if(!prg) return 1;
+	for(int i=0;i<fdsFileCount;i++){
+		FdsFile *f = &fdsFiles[i];
+		if(f->side || f->id > fdsBootId || f->type > 1) continue;
+
+		uint32_t lo = f->type ? 0x0000 : 0x8000;
+		uint32_t hi = f->type ? 0x2000 : 0xe000;
+		uint32_t start = f->addr > lo ? f->addr : lo;
+		uint32_t stop = f->addr + f->size < hi ? f->addr + f->size : hi;
+		if(start >= stop) continue;
+		uint8_t *dst = f->type ? prg + 32*1024 + start : prg + start-0x8000;
+		if(readAt(rom, f->offset + start-f->addr, dst, stop-start)) return 1;
+	}
+	// Game vectors live at $DFFA-$DFFF (NMI #3, reset, IRQ); the BIOS owns $FFFA
+	memcpy(prg + 0x7ffa, prg + 0x5ffa, 6);
+	return 0;
+}
+
+static uint8_t readNsf(FILE *rom){
+	long size = fileSize(rom);
+	if(size <= 128 || fread(nsfHeader, 128, 1, rom) != 1) return 1;
+	nsfDataLen = size-128;
+
+	uint16_t load = le16(nsfHeader+0x08);
+	int banked = 0;
+	for(int i=0;i<8;i++) banked |= nsfHeader[0x70+i];
+
+	// NSF-style bankswitching is mapper 31
+	uint8_t *prg = newImage(2, 0, banked ? 31 : 0, 0);
+	if(!prg) return 1;
+
+	if(!banked){
+		// Data is loaded as is from the load address up
+		uint32_t start = load > 0x8000 ? load : 0x8000;
+		uint32_t stop = load + nsfDataLen < 0x10000 ? load + nsfDataLen : 0x10000;
+		if(start < stop && readAt(rom, 128 + start-load, prg + start-0x8000, stop-start)) return 1;
+	} else{
+		// Map the initial banks; the low bits of the load address pad the first bank
+		for(int i=0;i<8;i++){
+			int64_t first = (int64_t)nsfHeader[0x70+i]*4096 - (load&0xfff);
+			int64_t start = first > 0 ? first : 0;
+			int64_t stop = first+4096 < nsfDataLen ? first+4096 : nsfDataLen;
+			if(start < stop && readAt(rom, 128+start, prg + i*4096 + (start-first), stop-start)) return 1;
+		}
+	}
+
+	// NSF has no vectors: the player calls init once and play every frame, which is
+	//  what reset and NMI do for a game, so those are shown in their place (IRQ too)
+	memcpy(prg + 0x7ffa, nsfHeader+0x0c, 2);
+	memcpy(prg + 0x7ffc, nsfHeader+0x0a, 2);
+	memcpy(prg + 0x7ffe, nsfHeader+0x0c, 2);
+	return 0;
+}
+
+// Sniff the container in rom and return a stream with its iNES layout, which is rom
+//  itself for iNES files; rom belongs to the returned stream, close it with closeRom()
+// Return NULL, leaving rom to the caller, for unknown or malformed files
+FILE *openRomImage(FILE *rom){
+	uint8_t magic[16] = {0};
+	uint8_t err;
+
+	free(image);
+	image = NULL;
+	fseek(rom, 0, SEEK_SET);
+	size_t n = fread(magic, 1, 16, rom);
+	fseek(rom, 0, SEEK_SET);
+
+	if(n >= 4 && !memcmp(magic, "NES\x1a", 4)){
+		romFormat = FMT_INES;
+		return rom;
+	} else if(n >= 4 && !memcmp(magic, "UNIF", 4)){
+		romFormat = FMT_UNIF;
+		err = readUnif(rom);
+	} else if((n >= 4 && !memcmp(magic, "FDS\x1a", 4)) || (n >= 15 && !memcmp(magic, "\x01*NINTENDO-HVC*", 15))){
+		romFormat = FMT_FDS;
+		err = readFds(rom);
+	} else if(n >= 5 && !memcmp(magic, "NESM\x1a", 5)){
+		romFormat = FMT_NSF;
+		err = readNsf(rom);
+	} else return NULL;
+
+	FILE *fp = err ? NULL : fmemopen(image, imageSize, "rb");
+	if(!fp){
+		free(image);
+		image = NULL;
+		return NULL;
+	}
+	fclose(rom);
+	return fp;
+}
+
+void closeRom(FILE *rom){
+	fclose(rom);
+	free(image);
+	image = NULL;
+}
+
+static void printUnifInfo(){
+	printf("UNIF image (revision %u):\n", unifRevision);
+	if(unifMapper < 0) printf(" Board: %s (not a known board, analyzed as mapper 0)\n", unifBoard[0] ? unifBoard : "none");
+	else printf(" Board: %s (mapper %d)\n", unifBoard, unifMapper);
+	for(int i=0;i<16;i++){
+		if(unifPrg[i].len) printf(" PRG%X: %u KiB at 0x%06x\n", i, unifPrg[i].len/1024, unifPrg[i].offset);
+	}
+	for(int i=0;i<16;i++){
+		if(unifChr[i].len) printf(" CHR%X: %u KiB at 0x%06x\n", i, unifChr[i].len/1024, unifChr[i].offset);
+	}
+	printf(
+		" Mirroring: %s\n",
+		unifMirroring == 0 ? "horizontal" : unifMirroring == 1 ? "vertical" :
+		unifMirroring == 4 ? "four-screen" : unifMirroring < 0 ? "unspecified" : "mapper-controlled"
+	);
+	printf(" Battery-backed: %s\n\n", unifBattery ? "yes" : "no");
+}
+
+static void printFdsInfo(){
+	printf("FDS image: %d side%s, game code %s, boot files up to ID %d\n", fdsSides, fdsSides > 1 ? "s" : "", fdsGameCode, fdsBootId);
+	for(int i=0;i<fdsFileCount;i++){
+		FdsFile *f = &fdsFiles[i];
+		if(!i || f->side != fdsFiles[i-1].side){
+			printf("\n Side %d%c:\n", f->side/2+1, 'A' + f->side%2);
+			printf("  No. ID  Name      Type  Address  Size\n");
+		}
+		printf(
+			"  %02x  %02x  %-8s  %-4s  $%04x    %5d%s\n",
+			f->number, f->id, f->name, f->type < 3 ? fdsFileTypes[f->type] : "?", f->addr, f->size,
+			f->hidden ? "  (hidden)" : (!f->side && f->id <= fdsBootId) ? "  (boot)" : ""
+		);
+	}
+	printf("\n");
+}
+
+static void printNsfInfo(){
+	char text[33];
+
+	printf("NSF v%d:\n", nsfHeader[5]);
+	text[32] = 0;
+	memcpy(text, nsfHeader+0x0e, 32);
+	printf(" Title: %s\n", text);
+	memcpy(text, nsfHeader+0x2e, 32);
+	printf(" Artist: %s\n", text);
+	memcpy(text, nsfHeader+0x4e, 32);
+	printf(" Copyright: %s\n", text);
+	printf(" Songs: %d (starting at %d)\n", nsfHeader[6], nsfHeader[7]);
+	printf(" Load address: $%04x\n", le16(nsfHeader+0x08));
+	printf(" Init address: $%04x\n", le16(nsfHeader+0x0a));
+	printf(" Play address: $%04x\n", le16(nsfHeader+0x0c));
+	printf(" Data size: %u B\n", nsfDataLen);
+
+	int banked = 0;
+	for(int i=0;i<8;i++) banked |= nsfHeader[0x70+i];
+	printf(" Bankswitching: %s", banked ? "yes, initial banks" : "no");
+	for(int i=0;banked && i<8;i++) printf(" %02x", nsfHeader[0x70+i]);
+	printf("\n");
+
+	uint8_t region = nsfHeader[0x7a]&0x03;
+	printf(" Region: %s\n", region == 0 ? "NTSC" : region == 1 ? "PAL" : "NTSC/PAL");
+	printf(" Play rate: %d us (NTSC), %d us (PAL)\n", le16(nsfHeader+0x6e), le16(nsfHeader+0x78));
+	printf(" Expansion audio:");
+	if(!(nsfHeader[0x7b]&0x7f)) printf(" none");
+	for(int i=0;i<7;i++) if(nsfHeader[0x7b] & 1<<i) printf(" %s", nsfChipNames[i]);
+	printf("\n\n");
+}
+
+void printFormatInfo(){
+	if(romFormat == FMT_UNIF) printUnifInfo();
+	else if(romFormat == FMT_FDS) printFdsInfo();
+	else if(romFormat == FMT_NSF) printNsfInfo();
+}
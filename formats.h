@@ -0,0 +1,30 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_FORMATS_H
+#define FC_FORMATS_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define FDS_SIDE_SIZE 65500
+#define FDS_MAX_FILES 512
+
+enum _rom_formats{
+	FMT_INES,
+	FMT_UNIF,
+	FMT_FDS,
+	FMT_NSF
+};
+
+extern int romFormat;
+extern const char *const romFormatNames[];
+
+FILE *openRomImage(FILE *rom);
+void closeRom(FILE *rom);
+void printFormatInfo();
+
+#endif
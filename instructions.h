@@ -83,13 +83,21 @@ enum _instructions{
 typedef struct{
 	uint8_t instr;
 	uint8_t addr_mode;
+	uint8_t cycles;     // Base cycle count (0 for invalid opcodes)
+	uint8_t page_cross; // 1 if crossing a page while indexing costs an extra cycle
 } Opcode;
 
+// Extra cycles for a taken branch; one more if the target is on another page
+#define BRANCH_TAKEN_CYCLES 1
+// OAM DMA stall after a write to 0x4014 (one more on an odd CPU cycle)
+#define OAM_DMA_CYCLES 513
+
 extern const uint8_t instruction_length[];
 extern const Opcode opcodes[];
 extern const char *const mnemonics[];
 
 
 uint16_t relative_addr(uint16_t addr, int8_t offset);
+uint8_t page_crossed(uint16_t a, uint16_t b);
 
 #endif
\ No newline at end of file
@@ -4,17 +4,37 @@
 	Licensed under MIT/Expat
 */
 
+#define _DEFAULT_SOURCE // realpath()
+
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include "base.h"
+#include "bootscan.h"
+#include "budget.h"
+#include "cdl.h"
+#include "chr.h"
+#include "codemap.h"
+#include "cpu.h"
+#include "diff.h"
 #include "disasm.h"
+#include "formats.h"
 #include "instructions.h"
+#include "mapcheck.h"
 #include "names.h"
+#include "ptrtables.h"
+#include "relsearch.h"
+#include "server.h"
+#include "signatures.h"
+#include "space.h"
+#include "summary.h"
+#include "watch.h"
+#include "xref.h"
 
-#define TILECMP(x, y) (!memcmp((x), (y), 16))
+#define TRACE_CYCLES 10000000
 
 typedef enum options{
 	OPT_VECTORS,
@@ -22,146 +42,69 @@ typedef enum options{
 	OPT_OFFICIAL,
 	OPT_INES,
 	OPT_DISASS,
+	OPT_CHR_PNG,
+	OPT_CHR_PGM,
+	OPT_CODEMAP,
+	OPT_TRACE,
+	OPT_BUDGET,
+	OPT_XREF,
+	OPT_WATCH,
+	OPT_ENTROPY,
+	OPT_RELSEARCH,
+	OPT_SIGNATURES,
+	OPT_PTRTABLES,
+	OPT_SANITY,
+	OPT_BOOTSCAN,
+	OPT_APPROX,
 	OPT_ALL,
 } options;
 
 void printUsage(){
 	printf(
-		"Display information about an FC/NES ROM file\n"
-		"Usage: fcinfo [option] ROM\n\n"
+		"Display information about an FC/NES ROM file (iNES, NES 2.0, UNIF, FDS or NSF)\n"
+		"Usage: fcinfo [option [argument]] ROM\n\n"
 		"'option' is one of:\n"
 		"\t-a\tShow all available information (sans disassembly)\n"
+		"\t-b\tEstimate NMI handler cycles against the vblank budget\n"
+		"\t-c\tExport CHR-ROM banks as PNG tile sheets (ROM.chrN.png)\n"
 		"\t-d\tDisassemble interrupt handlers (until first RTI/JMP) to stdout\n"
+		"\t-e\tDisplay free ROM space with PRG-ROM entropy and compressibility per bank\n"
+		"\t-E\tSame as -e, also profiling every 1 KiB window\n"
+		"\t-g\tExport CHR-ROM banks as PGM tile sheets (ROM.chrN.pgm)\n"
 		"\t-H\tDisplay iNES/NES 2.0 header information (default)\n"
+		"\t-k\tCheck the header for inconsistencies and infer the mapper from code\n"
+		"\t-m\tClassify PRG-ROM bytes as code/data and export the map (ROM.cmap)\n"
 		"\t-o\tDisplay official header information if present\n"
+		"\t-p\tFind candidate pointer tables in PRG-ROM\n"
+		"\t-r\tScan every PRG-ROM bank for reset vectors and guess the boot bank\n"
 		"\t-s\tDisplay free ROM space\n"
-		"\t-v\tDisplay hardware vectors\n\n"
+		"\t-S\tFind known code signatures (drivers, libraries, idioms) in PRG-ROM\n"
+		"\t-t\tRun reset code in a 6502 interpreter and log mapper writes\n"
+		"\t-v\tDisplay hardware vectors\n"
+		"\t-x\tList cross references and export FCEUX/Mesen/ca65 symbol files\n"
+		"\t--watch\tRe-analyze free space whenever the ROM is rewritten\n"
+		"\t--relsearch TEXT\n\t\tFind TEXT in PRG-ROM in any encoding with ordered letters; ROM may be a\n\t\tdirectory, to search every ROM under it\n"
+		"\t--relsearch-chr TEXT\n\t\tSame as --relsearch, also searching CHR-ROM\n"
+		"\t--ptrtables N\n\t\tSame as -p, with at least N entries per table (default %d)\n"
+		"\t--approx [FRACTION]\n\t\tEstimate free space from a FRACTION of PRG/CHR banks (default %.1f), with 95%% CIs\n"
+		"\t--sigdb FILE\n\t\tSame as -S, adding the signatures in FILE ('name = A9 ?? 8D' lines)\n"
+		"\t--serve SOCKET [SIGDB]\n\t\tStay resident and answer analysis requests on a Unix socket\n"
+		"\t--query SOCKET\n\t\tAsk a running --serve instance to analyze ROM\n"
+		"\t--summary DIR [--where EXPR]\n\t\tSummarize every ROM under DIR instead of a single ROM, or only those matching EXPR\n"
+		"\t--diff A B [PATCH]\n\t\tCompare ROM A to ROM B and write an IPS or BPS patch (by PATCH's extension)\n\n"
+		"A Code/Data Logger file next to ROM (ROM.cdl, as saved by FCEUX or Mesen) refines\n"
+		"-a, -e, -k, -m, -p, -s and -x, adds a never-touched space estimate, and makes -d\n"
+		"disassemble all logged code.\n\n"
+		"EXPR is a C-like expression over mapper, submapper, prg_kib, chr_kib, nes2, trainer,\n"
+		"battery, vertical, four_screen, file_size, official, free_prg and free_chr,\n"
+		"e.g. 'mapper == 4 && chr_kib >= 128 && !official'. In --summary, free space counts\n"
+		"filler runs only, with no code map, so it can be higher than -s reports.\n\n",
+		PTR_MIN_ENTRIES, SAMPLE_FRACTION
 	);
 }
 
-void readINesHeader(FILE *rom){
-	fread(iNesHeader, 16, 1, rom);
-	if(memcmp(iNesHeader, "NES\x1a", 4)){
-		fprintf(stderr, "This file isn't an NES ROM.\n");
-		exit(1);
-	}
-	isNes2 = ((iNesHeader[7]&0x0c) == 0x08);
-	mapper = (iNesHeader[6]>>4) | (iNesHeader[7]&0xf0) | (isNes2 ? (iNesHeader[8]&0xf)<<8 : 0);
-	hasTrainer = (iNesHeader[6]&0x04);
-
-	if(!isNes2){
-		prgSize = iNesHeader[4];
-		chrSize = iNesHeader[5];
-		return;
-	}
-
-	uint8_t prgSizeExtra = iNesHeader[9]&0x0f;
-	uint8_t chrSizeExtra = iNesHeader[9]>>4;
-
-	if(prgSizeExtra != 0x0f)
-		prgSize = iNesHeader[4] | prgSizeExtra<<8;
-	else{
-		// Use exponent multiplier notation
-		int exponent = iNesHeader[4]>>2;
-		int multiplier = iNesHeader[4]&0x03;
-
-		// PRG size = 2^exponent * (multiplier * 2 + 1) bytes
-		// NOTE: The conversion to 16 KiB banks may not be exact
-		prgSize = ((int64_t)0x01<<exponent) * (multiplier*2 + 1) / (16*1024);
-	}
-
-	if(chrSizeExtra != 0x0f)
-		chrSize = iNesHeader[5] | chrSizeExtra<<8;
-	else{
-		int exponent = iNesHeader[5]>>2;
-		int multiplier = iNesHeader[5]&0x03;
-
-		chrSize = ((int64_t)0x01<<exponent) * (multiplier*2 + 1) / (8*1024);
-	}
-}
-
-void readOfficialHeader(FILE *rom){
-	fseek(rom, 16+hasTrainer*512+16*1024*prgSize-32, SEEK_SET);
-	fread(officialHeader, 26, 1, rom);
-	hasOfficialHeader =
-		officialHeader[22] && officialHeader[22] < 3 &&
-		officialHeader[23] && officialHeader[23] < 16;
-
-	if(!(hasOfficialHeader)) return;
-	memcpy(gameTitle, &officialHeader[15-officialHeader[23]], officialHeader[23]+1);
-}
-
-void readHwVectors(FILE *rom){
-	fseek(rom, 16+hasTrainer*512+16*1024*prgSize-6, SEEK_SET);
-	fread(vectors, 2, 3, rom);
-
-	for(int i=0;i<3;i++){
-		absVectors[i] = getLastBankOffset(vectors[i]);
-	}
-}
-
-uint8_t countEmptySpace(FILE *rom){
-	emptySpacePrg = malloc(prgSize*sizeof(int));
-	uniqueTileCounter = malloc(2*chrSize*sizeof(int));
-	if(!emptySpacePrg || !uniqueTileCounter) return 1;
-
-	// Estimate empty space in PRG-ROM
-	int ch;
-	int64_t totalPrgBytes = 0;
-	fseek(rom, 16+hasTrainer*512, SEEK_SET);
-	for(int i=0;i<prgSize;i++){
-		int cnt00 = 0; // Current run of 0x00 bytes
-		int cntFF = 0; // Current run of 0xff bytes
-		emptySpacePrg[i] = 0;
-		for(int j=0; j<(16*1024) && (ch = fgetc(rom)) != EOF; j++){
-			totalPrgBytes++;
-			if (!ch){
-				cnt00++;
-			} else if(ch == 0xff){
-				cntFF++;
-			}else{
-				if     (cnt00 > emptySpacePrg[i]) emptySpacePrg[i] = cnt00;
-				else if(cntFF > emptySpacePrg[i]) emptySpacePrg[i] = cntFF;
-				cnt00 = cntFF = 0;
-			}
-		}
-		if     (cnt00 > emptySpacePrg[i]) emptySpacePrg[i] = cnt00;
-		else if(cntFF > emptySpacePrg[i]) emptySpacePrg[i] = cntFF;
-	}
-	if(totalPrgBytes < (prgSize * 16*1024)) return 1;
-
-	// Estimate free space in each 4 KiB page in CHR-ROM by counting unique tiles
-	int64_t totalChrTiles = 0;
-	fseek(rom, 16+hasTrainer*512+16*1024*prgSize, SEEK_SET);
-	for(int i =0;i<(chrSize*2);i++){
-		memset(uniqueTilesBuf, 0, 4096);
-		uniqueTileCounter[i] = 0;
-		for(int j=0;j<256;j++){
-			uint8_t tmp[16];
-			int uniqueTileFlag = 1;
-
-			if(!fread(tmp, 16, 1, rom)) break;
-			totalChrTiles++;
-			for(int k=0;k<uniqueTileCounter[i];k++){
-				if(TILECMP(tmp, uniqueTilesBuf[k])){
-					uniqueTileFlag = 0;
-					break;
-				}
-			}
-
-			if(uniqueTileFlag){
-				memcpy(uniqueTilesBuf[uniqueTileCounter[i]], tmp, 16);
-				uniqueTileCounter[i]++;
-			}
-		}
-	}
-	if(totalChrTiles < (chrSize * 2*256)) return 1;
-
-	return 0;
-}
-
 void printINesHeaderInfo(){
-	printf("%s header:\n", isNes2 ? "NES 2.0" : "iNES");
+	printf("%s header%s:\n", isNes2 ? "NES 2.0" : "iNES", romFormat != FMT_INES ? " (equivalent)" : "");
 	for(int i=0;i<8;i++) printf(" %02x", iNesHeader[i]);
 	printf(" ");
 	if(isNes2){
@@ -217,14 +160,77 @@ void printOfficialHeader(){
 	printf(" Mapper: %s\n\n", officialMapperNames[officialHeader[21]&0x07]);
 }
 
+void traceReset(FILE *rom){
+	const char *stopReasons[] = {
+		"cycle limit reached",
+		"idle loop",
+		"invalid opcode",
+		"fetch outside of RAM/ROM"
+	};
+	static Cpu cpu;
+
+	if(loadPrgRom(rom)){
+		printf("Reset trace failed: memory error or malformed ROM.\n\n");
+		return;
+	}
+	cpuReset(&cpu);
+	uint16_t entry = cpu.pc;
+	cpuStop stop = cpuRun(&cpu, TRACE_CYCLES);
+
+	printf("Reset trace from 0x%04x:\n", entry);
+	printf(
+		" Stopped at 0x%04x after %lu instructions (%lu cycles): %s\n\n",
+		cpu.pc, cpu.steps, cpu.cycles, stopReasons[stop]
+	);
+	printf(" Mapper register writes:\n");
+	if(!cpu.writeCount) printf("  none\n");
+	for(int i=0;i<cpu.writeCount;i++){
+		printf(
+			"  @%lu L%04X: $%04X <- $%02X\n",
+			cpu.writes[i].cycle, cpu.writes[i].pc, cpu.writes[i].addr, cpu.writes[i].val
+		);
+	}
+	if(cpu.writeCount == CPU_MAX_WRITES) printf("  (log full)\n");
+	printf("\n");
+}
+
+void printProfile(int bank){
+	const ByteProfile *p = &prgProfile[bank];
+	printf(
+		"  Entropy: %.2f bits/byte, %d distinct values, top 0x%02x (%d%%), LZ estimate: %d%%\n",
+		p->entropy, p->distinct, p->topByte, p->topCount*100/PRG_BANK_SIZE, p->lzSize*100/PRG_BANK_SIZE
+	);
+	if(profileLevel < 2) return;
+
+	const int windows = PRG_BANK_SIZE/PROFILE_WINDOW;
+	for(int w=0;w<windows;w++){
+		p = &prgWindowProfile[bank*windows + w];
+		printf(
+			"   0x%04x: %.2f bits/byte, LZ %3d%%\n",
+			w*PROFILE_WINDOW, p->entropy, p->lzSize*100/PROFILE_WINDOW
+		);
+	}
+}
+
+void printEstimate(const char *area, const char *unit, const char *measure, const SpaceEstimate *e){
+	double low = e->total - e->margin;
+	if(!e->units) return;
+	printf(" %s: %d of %d %ss sampled\n", area, e->sampled, e->units, unit);
+	printf("  Free space: %.0f %s (95%% CI %.0f-%.0f)\n", e->total, measure, low > 0 ? low : 0, e->total + e->margin);
+	printf("  Per %s: %.1f %s on average, %d-%d in the sample\n\n", unit, e->mean, measure, e->min, e->max);
+}
+
 void disassembleSub(FILE *rom, uint16_t addr){
 	Opcode op;
 	uint16_t nextAddr;
 	char str[128];
+	int total = 0;
 	do{
 		op = opcodes[(uint8_t)readMemory(rom, addr)];
 		nextAddr = disassemble(rom, addr, str, 128);
-		printf(" %s\n", str);
+		total += op.cycles;
+		// Base cycles, '+' if page crossing or a taken branch may add more, then running total
+		printf(" %s\t%d%s\t%d\n", str, op.cycles, (op.page_cross || op.addr_mode == AM_RELATIVE) ? "+" : "", total);
 		addr = nextAddr;
 	// We shouldn't see RTS in an interrupt handler, but guard against it anyway
 	} while(op.instr != INS_JMP && op.instr != INS_RTI && op.instr != INS_RTS);
@@ -238,12 +244,20 @@ int main(int argc, char *argv[]){
 
 	options opt = OPT_INES;
 	FILE *rom;
+	const char *romPath;
+	const char *optArg = NULL; // Argument of options that take one
+	int romArg = 1;
 	if(argv[1][0] == '-'){
+		romArg = 2;
 		switch(argv[1][1]){
 			case 'v':
 			opt = OPT_VECTORS;
 			break;
 
+			case 'p':
+			opt = OPT_PTRTABLES;
+			break;
+
 			case 's':
 			opt = OPT_SPACE;
 			break;
@@ -264,26 +278,157 @@ int main(int argc, char *argv[]){
 			opt = OPT_ALL;
 			break;
 
+			case 'b':
+			opt = OPT_BUDGET;
+			break;
+
+			case 'c':
+			opt = OPT_CHR_PNG;
+			break;
+
+			case 'e':
+			case 'E':
+			opt = OPT_ENTROPY;
+			profileLevel = argv[1][1] == 'E' ? 2 : 1;
+			break;
+
+			case 'g':
+			opt = OPT_CHR_PGM;
+			break;
+
+			case 'k':
+			opt = OPT_SANITY;
+			break;
+
+			case 'm':
+			opt = OPT_CODEMAP;
+			break;
+
+			case 'r':
+			opt = OPT_BOOTSCAN;
+			break;
+
+			case 'S':
+			opt = OPT_SIGNATURES;
+			break;
+
+			case 't':
+			opt = OPT_TRACE;
+			break;
+
+			case 'x':
+			opt = OPT_XREF;
+			break;
+
 			case 'h':
 			printUsage();
 			exit(0);
 
+			case '-':
+			if(!strcmp(argv[1], "--watch")){
+				opt = OPT_WATCH;
+				break;
+			}
+			if(!strcmp(argv[1], "--relsearch") || !strcmp(argv[1], "--relsearch-chr")){
+				// A directory is searched as a collection, one ROM per worker
+				struct stat st;
+				if(argc == 4 && !stat(argv[3], &st) && S_ISDIR(st.st_mode))
+					exit(relativeSearchCollection(argv[3], argv[2], !strcmp(argv[1], "--relsearch-chr")));
+				opt = OPT_RELSEARCH;
+				optArg = argv[2];
+				romArg = 3;
+				break;
+			}
+			if(!strcmp(argv[1], "--ptrtables")){
+				opt = OPT_PTRTABLES;
+				optArg = argv[2];
+				romArg = 3;
+				break;
+			}
+			if(!strcmp(argv[1], "--approx")){
+				opt = OPT_APPROX;
+				if(argc > 3){
+					optArg = argv[2];
+					romArg = 3;
+				}
+				break;
+			}
+			if(!strcmp(argv[1], "--sigdb")){
+				opt = OPT_SIGNATURES;
+				optArg = argv[2];
+				romArg = 3;
+				break;
+			}
+			if(!strcmp(argv[1], "--serve") && argc > 2){
+				exit(serveRequests(argv[2], argc > 3 ? argv[3] : NULL));
+			}
+			// Anything after DIR but a complete --where EXPR is a usage error
+			if(!strcmp(argv[1], "--summary") && (argc == 3 || (argc == 5 && !strcmp(argv[3], "--where")))){
+				exit(summarizeCollection(argv[2], argc == 5 ? argv[4] : NULL));
+			}
+			if(!strcmp(argv[1], "--diff") && argc > 3){
+				exit(diffRoms(argv[2], argv[3], argc > 4 ? argv[4] : NULL));
+			}
+			if(!strcmp(argv[1], "--query") && argc > 3){
+				// The server resolves paths from its own working directory
+				char *path = realpath(argv[3], NULL);
+				char *request = path ? malloc(strlen(path)+9) : NULL;
+				if(request == NULL){
+					perror("Error opening ROM");
+					exit(1);
+				}
+				sprintf(request, "analyze %s", path);
+				int ret = queryServer(argv[2], request);
+				free(request);
+				free(path);
+				exit(ret);
+			}
+			printUsage();
+			exit(1);
+
 			default:
 			printUsage();
 			exit(1);
 		}
-		rom = fopen(argv[2], "rb");
-	} else rom = fopen(argv[1], "rb");
+	}
+	if(argc <= romArg){
+		printUsage();
+		exit(1);
+	}
+	romPath = argv[romArg];
+
+	rom = fopen(romPath, "rb");
 
 	if(rom == NULL){
 		perror("Error opening ROM");
 		exit(1);
 	}
 
+	if(opt == OPT_WATCH){
+		fclose(rom);
+		exit(watchRom(romPath));
+	}
+
+	FILE *image = openRomImage(rom);
+	if(image == NULL){
+		fprintf(stderr, "This file isn't an NES ROM, UNIF, FDS or NSF image.\n");
+		exit(1);
+	}
+	rom = image;
+
 	readINesHeader(rom);
 	readOfficialHeader(rom);
 
-	if(opt == OPT_INES || opt == OPT_ALL) printINesHeaderInfo();
+	// A code/data log next to the ROM refines everything built on the code map
+	int useCdl =
+		opt == OPT_SPACE || opt == OPT_ALL || opt == OPT_ENTROPY || opt == OPT_CODEMAP ||
+		opt == OPT_XREF || opt == OPT_PTRTABLES || opt == OPT_SANITY || opt == OPT_DISASS;
+	if(useCdl && !loadCdl(romPath) && opt != OPT_DISASS) printf("Code/data log: %s\n\n", cdlPath);
+
+	if(opt == OPT_INES || opt == OPT_ALL){
+		printFormatInfo();
+		printINesHeaderInfo();
+	}
 	if((opt == OPT_ALL && hasOfficialHeader) || opt == OPT_OFFICIAL) printOfficialHeader();
 	if(opt == OPT_VECTORS || opt == OPT_ALL){
 		readHwVectors(rom);
@@ -292,23 +437,68 @@ int main(int argc, char *argv[]){
 		printf(" Entry point:  0x%04x (0x%06x)\n", vectors[1], absVectors[1]);
 		printf(" External IRQ: 0x%04x (0x%06x)\n\n", vectors[2], absVectors[2]);
 	}
-	if(opt == OPT_SPACE || opt == OPT_ALL){
+	if(opt == OPT_SPACE || opt == OPT_ALL || opt == OPT_ENTROPY || opt == OPT_CODEMAP || opt == OPT_XREF || opt == OPT_PTRTABLES || opt == OPT_SANITY){
+		// Best effort: without the map, free space falls back to filler runs only
+		readHwVectors(rom);
+		buildCodeMap(rom);
+	}
+	if(opt == OPT_CODEMAP){
+		char path[4096];
+		if(!codeMap){
+			printf("Code/data classification failed: memory error or malformed ROM.\n");
+		} else{
+			printCodeMapSummary();
+			snprintf(path, sizeof(path), "%s.cmap", romPath);
+			if(!exportCodeMap(path)) printf("Code/data map written to %s\n\n", path);
+		}
+	}
+	if(opt == OPT_SANITY || opt == OPT_ALL) printHeaderSanity(rom);
+	if(opt == OPT_SPACE || opt == OPT_ALL || opt == OPT_ENTROPY){
 		printf("ROM space:\n");
 		if(!countEmptySpace(rom)){
-			for(int i=0;i<prgSize;i++)
+			for(int i=0;i<prgSize;i++){
 				printf(" Free space in PRG-ROM bank %d: %d bytes\n", i, emptySpacePrg[i]);
+				if(profileLevel) printProfile(i);
+			}
 			printf("\n");
 			for(int i=0;i<(chrSize*2);i++)
 				printf(" Free space in CHR-ROM page %d: %d tiles\n", i, 256-uniqueTileCounter[i]);
 			printf("\n");
+			if(cdlPrg) printUntouched();
 		} else{
 			printf(" Free space analysis failed: memory error or malformed ROM.\n");
 		}
 	}
-	if(opt == OPT_DISASS){
+	if(opt == OPT_APPROX){
+		SpaceEstimate prg, chr;
+		double fraction = optArg ? atof(optArg) : SAMPLE_FRACTION;
+		if(fraction <= 0 || fraction > 1){
+			fprintf(stderr, "The sampling fraction must be greater than 0 and at most 1.\n");
+			exit(1);
+		}
+		printf("ROM space (estimated from filler runs in sampled banks):\n");
+		if(!estimateEmptySpace(rom, fraction, &prg, &chr)){
+			printEstimate("PRG-ROM", "bank", "bytes", &prg);
+			printEstimate("CHR-ROM", "page", "tiles", &chr);
+		} else{
+			printf(" Free space estimate failed: memory error or malformed ROM.\n");
+		}
+	}
+	if(opt == OPT_DISASS && cdlPrg){
+		readHwVectors(rom);
+		if(loadPrgRom(rom)){
+			printf("Disassembly failed: memory error or malformed ROM.\n");
+		} else{
+			printf("; Dissassembled by fcinfo from the code logged in %s\n", cdlPath);
+			printf("; Not guaranteed to be valid 6502 assembly; for reference only\n");
+			printf("; Column after the hex dump: cycles\n");
+			disassembleLogged();
+		}
+	} else if(opt == OPT_DISASS){
 		readHwVectors(rom);
 		printf("; Dissassembled by fcinfo\n");
 		printf("; Not guaranteed to be valid 6502 assembly; for reference only\n");
+		printf("; Columns after the hex dump: cycles, cumulative cycles\n");
 		printf("nmi:\n");
 		disassembleSub(rom, vectors[0]);
 		printf("\nreset:\n");
@@ -316,9 +506,53 @@ int main(int argc, char *argv[]){
 		printf("\nirq:\n");
 		disassembleSub(rom, vectors[2]);
 	}
+	if(opt == OPT_XREF){
+		if(buildXrefs()){
+			printf("Cross reference analysis failed: memory error or malformed ROM.\n");
+		} else{
+			printXrefs();
+			exportSymbols(romPath);
+		}
+	}
+	if(opt == OPT_RELSEARCH){
+		if(relativeSearch(rom, optArg, !strcmp(argv[1], "--relsearch-chr")) < 0)
+			printf("Relative search failed.\n");
+	}
+	if(opt == OPT_SIGNATURES){
+		if((optArg && loadSignatureFile(optArg)) || printSignatureMatches(rom) < 0)
+			printf("Signature scan failed: memory error, bad signature or malformed ROM.\n");
+		freeSignatures();
+	}
+	if(opt == OPT_PTRTABLES){
+		int minEntries = optArg ? atoi(optArg) : PTR_MIN_ENTRIES;
+		printPointerTables(rom, minEntries < 2 ? 2 : minEntries);
+	}
+	if(opt == OPT_TRACE) traceReset(rom);
+	if(opt == OPT_BOOTSCAN) printBootScan(rom);
+	if(opt == OPT_BUDGET){
+		readHwVectors(rom);
+		if(loadPrgRom(rom)) printf("NMI cycle budget analysis failed: memory error or malformed ROM.\n\n");
+		else printNmiBudget();
+	}
+	if(opt == OPT_CHR_PNG || opt == OPT_CHR_PGM){
+		if(!chrSize){
+			printf("This ROM has no CHR-ROM to export.\n");
+		} else{
+			printf("CHR-ROM tile sheets:\n");
+			if(exportChrSheets(rom, romPath, opt == OPT_CHR_PNG ? CHR_PNG : CHR_PGM))
+				printf(" CHR export failed: I/O error or malformed ROM.\n");
+			printf("\n");
+		}
+	}
 
 	free(emptySpacePrg);
 	free(uniqueTileCounter);
-	fclose(rom);
+	free(prgProfile);
+	free(prgWindowProfile);
+	free(codeMap);
+	free(xrefs);
+	free(prgRom);
+	unloadCdl();
+	closeRom(rom);
 	exit(0);
 }
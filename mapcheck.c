@@ -0,0 +1,292 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "base.h"
+#include "codemap.h"
+#include "instructions.h"
+#include "mapcheck.h"
+
+// Mapper inference from the code's own register writes.
+// Stores in traced code count as-is; elsewhere only store sequences that are unlikely
+//  to appear in data by chance (MMC1 serial writes, register pairs) are counted.
+
+#define PAIR_WINDOW 10 // Max bytes between the two stores of a register pair
+
+typedef struct{
+	int         mapper;
+	const char *name;
+	int         maxPrgKiB, maxChrKiB; // Largest licensed board, not emulator extensions
+	int8_t      chrRam;    // 1: CHR-RAM only, 0: either, -1: CHR-ROM only
+	uint8_t     latchBits; // Data bits a discrete board's latch decodes, 0 for ASICs
+} MapperInfo;
+
+static const MapperInfo mapperInfo[] = {
+	{0,  "NROM",     32,   8,    0,  0},
+	{1,  "MMC1",     512,  128,  0,  0},
+	{2,  "UxROM",    256,  0,    1,  0x0f},
+	{3,  "CNROM",    32,   32,   -1, 0x03},
+	{4,  "MMC3",     512,  256,  0,  0},
+	{5,  "MMC5",     1024, 1024, 0,  0},
+	{7,  "AxROM",    256,  0,    1,  0x17},
+	{9,  "MMC2",     128,  128,  -1, 0},
+	{10, "MMC4",     256,  128,  -1, 0},
+	{66, "GxROM",    128,  32,   -1, 0x33},
+	{69, "FME-7",    512,  256,  0,  0},
+};
+#define MAPPER_COUNT (int)(sizeof(mapperInfo)/sizeof(mapperInfo[0]))
+
+typedef struct{
+	int stores;       // Stores to 0x8000-0xFFFF in traced code
+	int mmc1Serial;   // STA reg, LSR A chains of 4+
+	int mmc1Reset;    // LDA #$80, STA reg
+	int mmc3Pairs;    // 0x8000 (even) then 0x8001 (odd)
+	int mmc3Other;    // Traced stores to A000-E001 register pairs
+	int fme7Pairs;    // 0x8000 then 0xA000
+	int mmc2Regs;     // Distinct 0xA000-0xF000 registers in traced code
+	int indexed;      // STA table,X/Y into ROM: bus conflict avoidance in discrete mappers
+	int latchValues;  // Traced stores whose value is known: an immediate or a table entry
+	uint8_t latchBits; // OR of those values
+	int mmc5;         // Stores to 0x5100-0x5130
+} Evidence;
+
+static const MapperInfo *findMapperInfo(int mapper){
+	for(int i=0;i<MAPPER_COUNT;i++){
+		if(mapperInfo[i].mapper == mapper) return &mapperInfo[i];
+	}
+	return NULL;
+}
+
+// Return the store target at offset, or -1 if it isn't an absolute store
+static int32_t storeTarget(uint32_t offset, uint32_t end, int *indexed){
+	if(offset+2 >= end) return -1;
+	Opcode op = opcodes[prgRom[offset]];
+	if(op.instr != INS_STA && op.instr != INS_STX && op.instr != INS_STY) return -1;
+	if(op.addr_mode != AM_ABSOLUTE && op.addr_mode != AM_INDEXED_ABSOLUTE_X && op.addr_mode != AM_INDEXED_ABSOLUTE_Y)
+		return -1;
+	if(indexed) *indexed = op.addr_mode != AM_ABSOLUTE;
+	return prgRom[offset+1] | prgRom[offset+2]<<8;
+}
+
+// 1 if the store at offset is directly preceded by a load, as register writes are
+static int afterLoad(uint32_t offset){
+	for(uint32_t len=2; len<=3; len++){
+		if(offset < len) break;
+		Opcode op = opcodes[prgRom[offset-len]];
+		if((op.instr == INS_LDA || op.instr == INS_LDX || op.instr == INS_LDY) && instruction_length[op.addr_mode] == len)
+			return 1;
+	}
+	return 0;
+}
+
+// Fold the value a traced store to ROM writes into ev, when it can be known statically:
+//  the immediate loaded just before it, or the first entries of the table it indexes,
+//  which a bus-conflict table fills with the very values written
+static void latchValue(Evidence *ev, uint32_t offset, uint16_t target, int indexed){
+	if(!indexed){
+		if(offset < 2 || (prgRom[offset-2] != 0xa9 && prgRom[offset-2] != 0xa2 && prgRom[offset-2] != 0xa0)) return;
+		ev->latchBits |= prgRom[offset-1];
+		ev->latchValues++;
+		return;
+	}
+	int32_t table = prgOffset(target);
+	if(table < 0) return;
+	// Stop at the first byte no discrete latch could take, which is past the table
+	for(int k=0; k<4 && table+k < prgSize*16*1024 && prgRom[table+k] < 0x40; k++){
+		ev->latchBits |= prgRom[table+k];
+		if(!k) ev->latchValues++;
+	}
+}
+
+// Find the next store within PAIR_WINDOW bytes that follows a load
+static int32_t nextStore(uint32_t offset, uint32_t end){
+	for(uint32_t k=offset+3; k<offset+3+PAIR_WINDOW && k<end; k++){
+		int32_t t = storeTarget(k, end, NULL);
+		if(t >= 0) return afterLoad(k) ? t : -1;
+	}
+	return -1;
+}
+
+static void gatherEvidence(Evidence *ev){
+	uint32_t end = prgSize*16*1024;
+	uint16_t mmc2Seen = 0;
+	memset(ev, 0, sizeof(Evidence));
+
+	for(uint32_t i=0;i<end;i++){
+		int indexed = 0;
+		int32_t t = storeTarget(i, end, &indexed);
+		if(t < 0) continue;
+
+		uint8_t cls = codeMap ? cmGet(i) : CM_UNKNOWN;
+		if(cls == CM_OPERAND || cls == CM_DATA) continue;
+		int traced = cls == CM_CODE;
+
+		if(t >= 0x5100 && t <= 0x5130){
+			if(traced) ev->mmc5 += 3;
+			else if(afterLoad(i)) ev->mmc5++;
+			continue;
+		}
+		if(t < 0x8000) continue;
+
+		if(traced){
+			ev->stores++;
+			if(indexed) ev->indexed++;
+			latchValue(ev, i, t, indexed);
+			if((t&0xe001) >= 0xa000) ev->mmc3Other++;
+			if(t >= 0xa000) mmc2Seen |= 1 << (t>>12);
+		}
+
+		// Register pairs, worth more when found in traced code
+		int32_t t2 = afterLoad(i) ? nextStore(i, end) : -1;
+		if(t2 >= 0x8000){
+			if((t&0xe001) == 0x8000 && (t2&0xe001) == 0x8001) ev->mmc3Pairs += traced ? 3 : 1;
+			if((t&0xe000) == 0x8000 && (t2&0xe000) == 0xa000) ev->fme7Pairs += traced ? 3 : 1;
+		}
+
+		// MMC1: reset write, then serial writes of one bit each
+		if(i >= 2 && prgRom[i-2] == 0xa9 && prgRom[i-1] == 0x80) ev->mmc1Reset++;
+		int chain = 1;
+		uint32_t k = i;
+		while(k+4 < end && prgRom[k+3] == 0x4a && storeTarget(k+4, end, NULL) >= 0x8000){
+			chain++;
+			k += 4;
+		}
+		if(chain >= 4){
+			ev->mmc1Serial++;
+			i = k+2;
+		}
+	}
+
+	for(int n=0xa;n<=0xf;n++){
+		if(mmc2Seen & (1<<n)) ev->mmc2Regs++;
+	}
+}
+
+// 1 if the ROM's sizes are possible on this mapper
+static int sizesFit(const MapperInfo *m){
+	if(prgSize*16 > m->maxPrgKiB) return 0;
+	if(m->chrRam == 1 && chrSize) return 0;
+	if(m->chrRam == -1 && !chrSize) return 0;
+	if(chrSize*8 > m->maxChrKiB && m->chrRam != 1) return 0;
+	return 1;
+}
+
+static int scoreMapper(const MapperInfo *m, const Evidence *ev){
+	int score = 0;
+	int structured = ev->mmc1Serial || ev->mmc3Pairs || ev->fme7Pairs || ev->mmc5;
+
+	switch(m->mapper){
+		case 0: score = ev->stores || structured ? 0 : 10; break;
+		case 1: score = ev->mmc1Serial*10 + ev->mmc1Reset*2; break;
+		case 4: score = ev->mmc3Pairs*6 + (ev->mmc3Pairs ? ev->mmc3Other*2 : 0); break;
+		case 5: score = ev->mmc5*3; break;
+		case 9:
+		case 10: score = ev->mmc2Regs >= 4 ? ev->mmc2Regs*4 : 0; break;
+		case 69: score = ev->fme7Pairs > ev->mmc3Pairs ? ev->fme7Pairs*6 : 0; break;
+
+		// Discrete boards: a single latch anywhere in ROM, often written through a table
+		default:
+		score = structured ? 0 : ev->indexed*4 + ev->stores;
+		// Written values tell the latches apart: a bit the board doesn't decode rules
+		//  it out, and each bit it does decode counts for it
+		if(ev->latchValues && (ev->latchBits & ~m->latchBits)) score /= 4;
+		else if(ev->latchValues) score += __builtin_popcount(ev->latchBits) * 4;
+		break;
+	}
+	if(!sizesFit(m)) score /= 10;
+	return score;
+}
+
+// Rank probable mappers; return the number of guesses written (at most MAX_GUESSES)
+// Expects the PRG-ROM and, ideally, the code map to be loaded
+int inferMapper(MapperGuess *guesses){
+	Evidence ev;
+	int scores[MAPPER_COUNT], total = 0, count = 0;
+
+	gatherEvidence(&ev);
+	for(int i=0;i<MAPPER_COUNT;i++){
+		scores[i] = scoreMapper(&mapperInfo[i], &ev);
+		total += scores[i];
+	}
+
+	// Equal evidence is reported as a tie, listing the declared mapper first
+	int last = 0;
+	while(count < MAX_GUESSES && total){
+		int best = 0;
+		for(int i=1;i<MAPPER_COUNT;i++){
+			if(scores[i] > scores[best] || (scores[i] == scores[best] && mapperInfo[i].mapper == mapper)) best = i;
+		}
+		if(!scores[best] || scores[best]*100/total < 5) break;
+		guesses[count].mapper = mapperInfo[best].mapper;
+		guesses[count].confidence = scores[best]*100/total;
+		guesses[count].tied = count && scores[best] == last;
+		if(count && guesses[count].tied) guesses[count-1].tied = 1;
+		count++;
+		last = scores[best];
+		scores[best] = 0;
+	}
+	return count;
+}
+
+void printHeaderSanity(FILE *rom){
+	MapperGuess guesses[MAX_GUESSES];
+	const MapperInfo *declared = findMapperInfo(mapper);
+	int warnings = 0;
+
+	printf("Header sanity:\n");
+	printf(" Declared mapper: %d (%s)\n", mapper, declared ? declared->name : "not modeled");
+
+	// The file has to hold everything the header promises
+	fseek(rom, 0, SEEK_END);
+	long fileSize = ftell(rom);
+	long expected = 16 + hasTrainer*512 + prgSize*16*1024 + chrSize*8*1024;
+	if(fileSize < expected){
+		printf(" Warning: file is %ld bytes, header needs %ld\n", fileSize, expected);
+		warnings++;
+	} else if(fileSize > expected && !(isNes2 && iNesHeader[14])){
+		printf(" Warning: %ld bytes past the end of CHR-ROM\n", fileSize - expected);
+		warnings++;
+	}
+	if(prgSize & (prgSize-1)){
+		printf(" Warning: PRG-ROM size (%ld KiB) isn't a power of two\n", prgSize*16);
+		warnings++;
+	}
+	if(!isNes2 && (iNesHeader[7]&0x0c) == 0x04){
+		printf(" Warning: bytes 7-15 look like leftover text (old \"DiskDude!\" style header)\n");
+		warnings++;
+	}
+	if(declared && !sizesFit(declared)){
+		printf(
+			" Warning: %s doesn't support %ld KiB PRG-ROM with %ld KiB CHR-%s\n",
+			declared->name, prgSize*16, chrSize ? chrSize*8 : 8, chrSize ? "ROM" : "RAM"
+		);
+		warnings++;
+	}
+
+	if(loadPrgRom(rom)){
+		printf(" Mapper inference failed: memory error or malformed ROM.\n\n");
+		return;
+	}
+	int count = inferMapper(guesses);
+	if(!count){
+		printf(" Probable mapper: no evidence\n");
+	} else{
+		printf(" Probable mapper:\n");
+		for(int i=0;i<count;i++){
+			const MapperInfo *m = findMapperInfo(guesses[i].mapper);
+			printf("  %3d %-6s %3d%%%s\n", m->mapper, m->name, guesses[i].confidence, guesses[i].tied ? " (tied)" : "");
+		}
+		if(guesses[0].mapper != mapper && guesses[0].confidence >= 60){
+			printf(" Warning: code looks like %s, not mapper %d\n", findMapperInfo(guesses[0].mapper)->name, mapper);
+			warnings++;
+		}
+	}
+	if(!warnings) printf(" No inconsistencies found\n");
+	printf("\n");
+}
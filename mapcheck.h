@@ -0,0 +1,24 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_MAPCHECK_H
+#define FC_MAPCHECK_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct{
+	int mapper;
+	int confidence; // Percent
+	int tied;       // Same evidence as a neighboring guess
+} MapperGuess;
+
+#define MAX_GUESSES 4
+
+int inferMapper(MapperGuess *guesses);
+void printHeaderSanity(FILE *rom);
+
+#endif
@@ -149,4 +149,62 @@ const char *const officialMapperNames[] = {
 	"UNROM",
 	"GNROM",
 	"MMC"
-};
\ No newline at end of file
+};
+
+// https://www.nesdev.org/wiki/PPU_registers
+const char *const ppuRegisterNames[] = {
+	"PPUCTRL",
+	"PPUMASK",
+	"PPUSTATUS",
+	"OAMADDR",
+	"OAMDATA",
+	"PPUSCROLL",
+	"PPUADDR",
+	"PPUDATA"
+};
+
+// https://www.nesdev.org/wiki/APU_registers
+const char *const apuRegisterNames[] = {
+	"SQ1_VOL",
+	"SQ1_SWEEP",
+	"SQ1_LO",
+	"SQ1_HI",
+	"SQ2_VOL",
+	"SQ2_SWEEP",
+	"SQ2_LO",
+	"SQ2_HI",
+	"TRI_LINEAR",
+	"APU_UNUSED1",
+	"TRI_LO",
+	"TRI_HI",
+	"NOISE_VOL",
+	"APU_UNUSED2",
+	"NOISE_LO",
+	"NOISE_HI",
+	"DMC_FREQ",
+	"DMC_RAW",
+	"DMC_START",
+	"DMC_LEN",
+	"OAMDMA",
+	"SND_CHN",
+	"JOY1",
+	"JOY2"
+};
+
+// https://www.nesdev.org/wiki/NSF#Header_Overview
+const char *const nsfChipNames[] = {
+	"VRC6",
+	"VRC7",
+	"FDS",
+	"MMC5",
+	"Namco 163",
+	"Sunsoft 5B",
+	"VT02+"
+};
+
+// https://www.nesdev.org/wiki/FDS_disk_format
+const char *const fdsFileTypes[] = {
+	"PRG",
+	"CHR",
+	"NT"
+};
@@ -15,5 +15,9 @@ extern const char *const inputTypes[];
 extern const char *const officialPrgSizes[];
 extern const char *const officialChrSizes[];
 extern const char *const officialMapperNames[];
+extern const char *const ppuRegisterNames[];
+extern const char *const apuRegisterNames[];
+extern const char *const nsfChipNames[];
+extern const char *const fdsFileTypes[];
 
 #endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "parallel.h"
+
+#define MAX_WORKERS 64
+
+typedef struct{
+	int              count;
+	int              next; // Next unclaimed index, shared by all workers
+	parallelFn       fn;
+	parallelWorkerFn workerFn; // Used instead of fn if set
+	void             *ctx;
+} Job;
+
+typedef struct{
+	Job *job;
+	int id;
+} Worker;
+
+static void *worker(void *arg){
+	Worker *w = arg;
+	Job *job = w->job;
+	int i;
+	while((i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < job->count){
+		if(job->workerFn) job->workerFn(w->id, i, job->ctx);
+		else job->fn(i, job->ctx);
+	}
+	return NULL;
+}
+
+// Number of online CPUs, capped to MAX_WORKERS
+int workerCount(){
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	if(n < 1) return 1;
+	return n > MAX_WORKERS ? MAX_WORKERS : n;
+}
+
+static void runJob(Job *job, int minPerThread){
+	pthread_t threads[MAX_WORKERS];
+	Worker workers[MAX_WORKERS];
+	int n = workerCount();
+
+	if(minPerThread < 1) minPerThread = 1;
+	if(n > job->count/minPerThread) n = job->count/minPerThread;
+
+	int started = 0;
+	for(; started<n-1; started++){
+		workers[started] = (Worker){job, started+1};
+		if(pthread_create(&threads[started], NULL, worker, &workers[started])) break;
+	}
+	// The calling thread works too, which also covers thread creation failures
+	Worker self = {job, 0};
+	worker(&self);
+	for(int i=0;i<started;i++) pthread_join(threads[i], NULL);
+}
+
+// Call fn(i, ctx) for every i in [0, count), spread over worker threads
+// Small jobs (fewer than 2*minPerThread items) run on the calling thread only
+void parallelFor(int count, int minPerThread, parallelFn fn, void *ctx){
+	Job job = {count, 0, fn, NULL, ctx};
+	runJob(&job, minPerThread);
+}
+
+// Same as parallelFor(), also passing fn the index of the worker calling it, which is
+//  below workerCount(); lets callers keep per-worker partial results without locking
+void parallelForWorkers(int count, int minPerThread, parallelWorkerFn fn, void *ctx){
+	Job job = {count, 0, NULL, fn, ctx};
+	runJob(&job, minPerThread);
+}
@@ -0,0 +1,17 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_PARALLEL_H
+#define FC_PARALLEL_H
+
+typedef void (*parallelFn)(int index, void *ctx);
+typedef void (*parallelWorkerFn)(int worker, int index, void *ctx);
+
+int workerCount();
+void parallelFor(int count, int minPerThread, parallelFn fn, void *ctx);
+void parallelForWorkers(int count, int minPerThread, parallelWorkerFn fn, void *ctx);
+
+#endif
@@ -0,0 +1,159 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "base.h"
+#include "codemap.h"
+#include "ptrtables.h"
+
+#define PTR_MIN_SCORE 55
+#define PTR_MAX_SHOWN 16 // Targets listed per table
+
+enum _ptr_windows{
+	WIN_NONE,
+	WIN_RAM,
+	WIN_SRAM,
+	WIN_PRG_LO, // 0x8000-0xBFFF
+	WIN_PRG_HI  // 0xC000-0xFFFF
+};
+
+// Which CPU window a pointer lands in, using the same bank model as getLastBankOffset
+static int targetWindow(uint16_t addr){
+	if(addr == 0x0000 || addr == 0xffff) return WIN_NONE; // Filler, not pointers
+	if(addr < 0x0800) return WIN_RAM;
+	if(addr >= 0x6000 && addr < 0x8000) return WIN_SRAM;
+	if(addr < 0x8000) return WIN_NONE;
+	// With 32 KiB or less the whole of PRG is one window
+	if(prgSize <= 2) return WIN_PRG_HI;
+	return (addr&0x4000) ? WIN_PRG_HI : WIN_PRG_LO;
+}
+
+// A word is usable if it lands somewhere plausible and isn't itself decoded as code
+static int wordWindow(uint32_t offset){
+	if(codeMap){
+		uint8_t c0 = cmGet(offset), c1 = cmGet(offset+1);
+		if(c0 == CM_CODE || c0 == CM_OPERAND || c1 == CM_CODE || c1 == CM_OPERAND) return WIN_NONE;
+	}
+	return targetWindow(prgRom[offset] | prgRom[offset+1]<<8);
+}
+
+static int scoreTable(PointerTable *t){
+	int distinct = 1, ascending = 0, classified = 0, misaligned = 0;
+	uint16_t prev = prgRom[t->offset] | prgRom[t->offset+1]<<8;
+	t->lo = t->hi = prev;
+
+	for(int i=0;i<t->entries;i++){
+		uint16_t w = prgRom[t->offset + i*2] | prgRom[t->offset + i*2 + 1]<<8;
+		if(i){
+			if(w != prev) distinct++;
+			if(w > prev) ascending++;
+		}
+		if(w < t->lo) t->lo = w;
+		if(w > t->hi) t->hi = w;
+
+		int32_t target = prgOffset(w);
+		if(codeMap && target >= 0 && cmGet(target) == CM_OPERAND) misaligned++;
+		else if(codeMap && target >= 0 && cmGet(target) != CM_UNKNOWN) classified++;
+		prev = w;
+	}
+
+	int len = t->entries > 32 ? 32 : t->entries;
+	int score = len * 30 / 32;                       // Longer runs are less likely by chance
+	score += distinct * 25 / t->entries;             // Tables of one repeated word are usually fill
+	score += ascending * 15 / (t->entries-1);        // Data pointed to is often laid out in order
+	score += (t->hi - t->lo) < 0x2000 ? 10 : 0;      // Targets cluster together
+	if(codeMap) score += classified * 20 / t->entries; // Targets known to be code or data
+	else score += 10;
+	score -= misaligned * 40 / t->entries;           // Pointing into the middle of an instruction
+	return t->score = score < 0 ? 0 : score > 100 ? 100 : score;
+}
+
+static int compareTables(const void *a, const void *b){
+	const PointerTable *x = a, *y = b;
+	if(x->score != y->score) return y->score - x->score;
+	return (x->offset > y->offset) - (x->offset < y->offset);
+}
+
+static int addTable(PointerTable **tables, int *count, int *cap, uint32_t offset, int entries){
+	if(*count == *cap){
+		PointerTable *t = realloc(*tables, (*cap *= 2)*sizeof(PointerTable));
+		if(!t) return 1;
+		*tables = t;
+	}
+	PointerTable *t = &(*tables)[*count];
+	t->offset = offset;
+	t->entries = entries;
+	if(scoreTable(t) >= PTR_MIN_SCORE) (*count)++;
+	return 0;
+}
+
+// Find runs of at least minEntries words pointing into one CPU window
+// One pass per bank and word alignment; return the number of candidates (sorted by score) or -1
+int findPointerTables(PointerTable **out, int minEntries){
+	int count = 0, cap = 64;
+	PointerTable *tables = malloc(cap*sizeof(PointerTable));
+	if(!tables) return -1;
+
+	// Runs don't cross bank boundaries, where the mapping may change
+	for(uint32_t bank=0; bank<prgSize; bank++){
+		uint32_t bankEnd = (bank+1)*16*1024;
+		for(uint32_t parity=0; parity<2; parity++){
+			uint32_t runStart = bank*16*1024 + parity;
+			int runWindow = WIN_NONE;
+			for(uint32_t i=runStart; ; i+=2){
+				int w = i+1 < bankEnd ? wordWindow(i) : WIN_NONE;
+				if(w == runWindow && w != WIN_NONE) continue;
+
+				int entries = (i - runStart)/2;
+				if(runWindow != WIN_NONE && entries >= minEntries && addTable(&tables, &count, &cap, runStart, entries)){
+					free(tables);
+					return -1;
+				}
+				if(i+1 >= bankEnd) break;
+				runStart = i;
+				runWindow = w;
+			}
+		}
+	}
+
+	qsort(tables, count, sizeof(PointerTable), compareTables);
+	*out = tables;
+	return count;
+}
+
+void printPointerTables(FILE *rom, int minEntries){
+	PointerTable *tables;
+
+	if(loadPrgRom(rom)){
+		printf("Pointer table scan failed: memory error or malformed ROM.\n\n");
+		return;
+	}
+	int count = findPointerTables(&tables, minEntries);
+	if(count < 0){
+		printf("Pointer table scan failed: memory error.\n\n");
+		return;
+	}
+
+	printf("Pointer table candidates (%d+ entries):\n", minEntries);
+	if(!count) printf(" None\n");
+	for(int i=0;i<count;i++){
+		PointerTable *t = &tables[i];
+		int32_t cpu = cpuAddress(t->offset);
+		printf(" PRG-ROM bank %u 0x%06x", t->offset/(16*1024), t->offset);
+		if(cpu >= 0) printf(" (CPU 0x%04x)", cpu);
+		printf(": %d entries to 0x%04x-0x%04x, score %d\n ", t->entries, t->lo, t->hi, t->score);
+
+		for(int k=0;k<t->entries && k<PTR_MAX_SHOWN;k++)
+			printf(" %04x", prgRom[t->offset + k*2] | prgRom[t->offset + k*2 + 1]<<8);
+		if(t->entries > PTR_MAX_SHOWN) printf(" ...");
+		printf("\n");
+	}
+	printf("\n");
+	free(tables);
+}
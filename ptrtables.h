@@ -0,0 +1,25 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_PTRTABLES_H
+#define FC_PTRTABLES_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define PTR_MIN_ENTRIES 6
+
+typedef struct{
+	uint32_t offset;  // PRG-ROM offset of the first entry
+	int      entries;
+	int      score;   // 0-100
+	uint16_t lo, hi;  // Target range
+} PointerTable;
+
+int findPointerTables(PointerTable **out, int minEntries);
+void printPointerTables(FILE *rom, int minEntries);
+
+#endif
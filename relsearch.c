@@ -0,0 +1,264 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#define _GNU_SOURCE // memmem(), open_memstream(), nftw()
+
+#include <ctype.h>
+#include <ftw.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "parallel.h"
+#include "relsearch.h"
+
+// Relative search: text in an unknown encoding is found by matching the differences
+//  between consecutive letters, which survive any encoding that keeps the alphabet in order.
+
+#define MAX_QUERY 64
+
+typedef struct{
+	int     len;             // Query length in characters
+	int16_t delta[MAX_QUERY]; // Expected byte difference to the next character, -1 if unknown
+	int     anchor, anchorLen; // Longest run of known deltas, used as the search key
+	uint8_t key[MAX_QUERY];
+} Pattern;
+
+// Letters only have a known distance to letters of the same case; digits likewise
+static int charClass(char c){
+	if(isupper((unsigned char)c)) return 1;
+	if(islower((unsigned char)c)) return 2;
+	if(isdigit((unsigned char)c)) return 3;
+	return 0;
+}
+
+static int compilePattern(const char *query, Pattern *pat){
+	pat->len = strlen(query);
+	if(pat->len < 3 || pat->len > MAX_QUERY) return 1;
+
+	int runStart = 0;
+	pat->anchor = pat->anchorLen = 0;
+	for(int i=0;i<pat->len-1;i++){
+		int cls = charClass(query[i]);
+		if(cls && cls == charClass(query[i+1])){
+			pat->delta[i] = (uint8_t)(query[i+1] - query[i]);
+		} else{
+			pat->delta[i] = -1;
+			runStart = i+1;
+			continue;
+		}
+		if(i+1 - runStart > pat->anchorLen){
+			pat->anchor = runStart;
+			pat->anchorLen = i+1 - runStart;
+		}
+	}
+	if(pat->anchorLen < 2) return 1;
+
+	for(int i=0;i<pat->anchorLen;i++) pat->key[i] = pat->delta[pat->anchor+i];
+	return 0;
+}
+
+// cpuAddress() for a ROM of prgBanks 16 KiB banks, which need not be the loaded one
+static int32_t blockCpuAddress(uint32_t offset, int64_t prgBanks){
+	uint32_t bank = offset / (16*1024);
+	if(bank == prgBanks-1) return 0xC000 | (offset&0x3FFF);
+	if(prgBanks >= 2 && bank == prgBanks-2) return 0x8000 | (offset&0x3FFF);
+	return -1;
+}
+
+// Search one block and print its matches to out; return the number of matches
+// prgBanks is the PRG-ROM size of the block's ROM, for CPU addresses
+static int searchBlock(const uint8_t *data, size_t len, const char *query, const Pattern *pat, int isChr, int64_t prgBanks, FILE *out){
+	int found = 0;
+	if(len < (size_t)pat->len) return 0;
+
+	// Difference stream: deltas[i] = data[i+1] - data[i]
+	uint8_t *deltas = malloc(len);
+	if(!deltas) return 0;
+	for(size_t i=0;i<len-1;i++) deltas[i] = data[i+1] - data[i];
+
+	// glibc's memmem is vectorized, so it does the heavy lifting as a candidate filter;
+	//  the rest of the pattern (around any wildcards) is checked afterwards
+	const uint8_t *p = deltas;
+	const uint8_t *end = deltas + len-1;
+	while(p < end && (p = memmem(p, end-p, pat->key, pat->anchorLen))){
+		long start = (p - deltas) - pat->anchor;
+		p++;
+		if(start < 0 || start + pat->len > (long)len) continue;
+
+		int ok = 1;
+		for(int i=0;i<pat->len-1 && ok;i++){
+			if(pat->delta[i] >= 0 && deltas[start+i] != pat->delta[i]) ok = 0;
+		}
+		if(!ok) continue;
+
+		// Value of 'A' (or 'a'/'0') in the game's encoding, from the first letter of the
+		//  anchor: only letters whose deltas were matched are known to be in the table
+		int q0 = pat->anchor;
+		char base = charClass(query[q0]) == 1 ? 'A' : charClass(query[q0]) == 2 ? 'a' : '0';
+		uint8_t tableBase = data[start+q0] - (query[q0] - base);
+
+		if(isChr){
+			fprintf(out, " CHR-ROM 0x%06lx", start);
+		} else{
+			int32_t cpu = blockCpuAddress(start, prgBanks);
+			fprintf(out, " PRG-ROM bank %ld 0x%06lx", start/(16*1024), start);
+			if(cpu >= 0) fprintf(out, " (CPU 0x%04x)", cpu);
+		}
+		fprintf(out, ": '%c' = 0x%02x\n", base, tableBase);
+		found++;
+	}
+
+	free(deltas);
+	return found;
+}
+
+static uint8_t checkedPattern(const char *query, Pattern *pat){
+	if(!compilePattern(query, pat)) return 0;
+	fprintf(stderr, "Relative search needs at least 3 consecutive letters of the same case.\n");
+	return 1;
+}
+
+// Print every match of query in PRG-ROM (and CHR-ROM if searchChr is set)
+// Return the number of matches, or -1 on error
+int relativeSearch(FILE *rom, const char *query, int searchChr){
+	Pattern pat;
+	if(checkedPattern(query, &pat)) return -1;
+	if(loadPrgRom(rom)) return -1;
+
+	printf("Relative search for \"%s\":\n", query);
+	int found = searchBlock(prgRom, prgSize*16*1024, query, &pat, 0, prgSize, stdout);
+
+	if(searchChr && chrSize){
+		uint8_t *chr = malloc(chrSize*8*1024);
+		if(!chr) return -1;
+		fseek(rom, 16+hasTrainer*512+16*1024*prgSize, SEEK_SET);
+		if(fread(chr, chrSize*8*1024, 1, rom)) found += searchBlock(chr, chrSize*8*1024, query, &pat, 1, prgSize, stdout);
+		free(chr);
+	}
+
+	if(!found) printf(" No matches\n");
+	printf("\n");
+	return found;
+}
+
+// Batch search: every iNES ROM under a directory is searched by whichever worker claims
+//  it, into its own buffer; buffers are printed in path order once all are done
+
+typedef struct{
+	char   *text; // Matches as printed, NULL if none
+	size_t len;
+	int    found;
+} FileMatches;
+
+typedef struct{
+	const char    *query;
+	const Pattern *pat;
+	int           searchChr;
+	FileMatches   *results;
+} BatchJob;
+
+static char **paths;
+static int pathCount, pathCap;
+
+static int collectPath(const char *path, const struct stat *st, int type, struct FTW *ftw){
+	(void)st;
+	(void)ftw;
+	if(type != FTW_F) return 0;
+	if(pathCount == pathCap){
+		pathCap = pathCap ? pathCap*2 : 1024;
+		char **grown = realloc(paths, pathCap*sizeof(char *));
+		if(!grown) return 1;
+		paths = grown;
+	}
+	if(!(paths[pathCount] = strdup(path))) return 1;
+	pathCount++;
+	return 0;
+}
+
+static int comparePaths(const void *a, const void *b){
+	return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static void searchFile(int i, void *ctx){
+	BatchJob *job = ctx;
+	FileMatches *res = &job->results[i];
+	uint8_t header[16];
+
+	FILE *fp = fopen(paths[i], "rb");
+	if(fp == NULL) return;
+	fseek(fp, 0, SEEK_END);
+	long size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	if(size < 16 || fread(header, 16, 1, fp) != 1 || memcmp(header, "NES\x1a", 4)){
+		fclose(fp);
+		return;
+	}
+
+	// Same decoding as the single-ROM search, on this file's own copy
+	RomLayout rom;
+	decodeINesHeader(header, &rom);
+	long prgLen = rom.prgSize*16*1024, chrLen = job->searchChr ? rom.chrSize*8*1024 : 0;
+	long base = 16 + (rom.hasTrainer ? 512 : 0);
+	uint8_t *data = size >= base + prgLen + chrLen ? malloc(prgLen + chrLen + 1) : NULL;
+	if(data && (fseek(fp, base, SEEK_SET) || (prgLen + chrLen && fread(data, prgLen + chrLen, 1, fp) != 1))){
+		free(data);
+		data = NULL;
+	}
+	fclose(fp);
+	if(!data) return;
+
+	FILE *out = open_memstream(&res->text, &res->len);
+	if(out){
+		res->found = searchBlock(data, prgLen, job->query, job->pat, 0, rom.prgSize, out);
+		if(chrLen) res->found += searchBlock(data + prgLen, chrLen, job->query, job->pat, 1, rom.prgSize, out);
+		fclose(out);
+	}
+	free(data);
+}
+
+// Search every iNES ROM under dir; return the process exit status
+int relativeSearchCollection(const char *dir, const char *query, int searchChr){
+	Pattern pat;
+	if(checkedPattern(query, &pat)) return 1;
+
+	if(nftw(dir, collectPath, 64, FTW_PHYS)){
+		perror("Error reading directory");
+		return 1;
+	}
+	qsort(paths, pathCount, sizeof(char *), comparePaths);
+
+	FileMatches *results = calloc(pathCount+1, sizeof(FileMatches));
+	if(!results){
+		printf("Relative search failed: memory error.\n");
+		return 1;
+	}
+	BatchJob job = {query, &pat, searchChr, results};
+	// Files are handed out one at a time: their sizes vary too much for fixed chunks
+	parallelFor(pathCount, 1, searchFile, &job);
+
+	int found = 0, files = 0;
+	printf("Relative search for \"%s\" in %s:\n", query, dir);
+	for(int i=0;i<pathCount;i++){
+		if(results[i].found){
+			printf("%s:\n", paths[i]);
+			fwrite(results[i].text, results[i].len, 1, stdout);
+			found += results[i].found;
+			files++;
+		}
+		free(results[i].text);
+		free(paths[i]);
+	}
+	printf(" %d matches in %d of %d files\n\n", found, files, pathCount);
+
+	free(results);
+	free(paths);
+	paths = NULL;
+	pathCount = pathCap = 0;
+	return 0;
+}
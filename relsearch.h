@@ -0,0 +1,16 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_RELSEARCH_H
+#define FC_RELSEARCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+int relativeSearch(FILE *rom, const char *query, int searchChr);
+int relativeSearchCollection(const char *dir, const char *query, int searchChr);
+
+#endif
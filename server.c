@@ -0,0 +1,362 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#define _GNU_SOURCE // fmemopen(), open_memstream()
+
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "base.h"
+#include "codemap.h"
+#include "formats.h"
+#include "parallel.h"
+#include "server.h"
+#include "signatures.h"
+#include "space.h"
+#include "xref.h"
+
+// Resident mode: one request line per connection on a Unix socket, one JSON object
+//  line back, then the server hangs up.
+//   header PATH       iNES/official header and vectors only
+//   analyze PATH      header, free space and signature matches
+//   bytes N           same as analyze, for the N bytes of ROM that follow the line
+// The main thread polls the connections and hands those with a request waiting to a
+//  pool of threads, so idle clients never hold a worker. Header requests for iNES files are
+//  answered from local buffers; the analyses work on the process-wide ROM state, so
+//  they run one at a time under analysisLock.
+
+#define MAX_REQUEST_BYTES (64*1024*1024)
+#define MAX_CONNECTIONS   1024 // Waiting for a request, and queued for a worker
+#define REQUEST_TIMEOUT   2    // Seconds a started request may stall before it's dropped
+
+static pthread_mutex_t analysisLock = PTHREAD_MUTEX_INITIALIZER;
+static int listenFd = -1;
+
+// Connections with a request ready, waiting for a worker
+static pthread_mutex_t queueLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queueReady = PTHREAD_COND_INITIALIZER;
+static int readyFds[MAX_CONNECTIONS];
+static int readyHead, readyCount;
+
+// Drop everything the previous request loaded
+static void resetAnalysis(){
+	free(prgRom);
+	free(codeMap);
+	free(xrefs);
+	free(emptySpacePrg);
+	free(uniqueTileCounter);
+	prgRom = codeMap = NULL;
+	xrefs = NULL;
+	emptySpacePrg = uniqueTileCounter = NULL;
+	xrefCount = 0;
+	hasOfficialHeader = 0;
+	memset(gameTitle, 0, sizeof(gameTitle));
+	memset(vectors, 0, sizeof(vectors));
+}
+
+static void jsonString(FILE *js, const char *s, size_t maxLen){
+	fputc('"', js);
+	for(size_t i=0; i<maxLen && s[i]; i++){
+		unsigned char c = s[i];
+		if(c == '"' || c == '\\') fprintf(js, "\\%c", c);
+		else if(c < 0x20 || c >= 0x7f) fprintf(js, "\\u%04x", c);
+		else fputc(c, js);
+	}
+	fputc('"', js);
+}
+
+typedef struct{
+	FILE *js;
+	int matches;
+} SigList;
+
+static void jsonSignature(const Signature *sig, uint32_t offset, void *ctx){
+	SigList *list = ctx;
+	fprintf(list->js, "%s{\"name\":", list->matches++ ? "," : "");
+	jsonString(list->js, sig->name, sizeof(sig->name));
+	fprintf(list->js, ",\"offset\":%u,\"cpu\":%d}", offset, cpuAddress(offset));
+}
+
+static void jsonError(FILE *js, const char *msg){
+	fprintf(js, "{\"ok\":false,\"error\":");
+	jsonString(js, msg, 256);
+	fprintf(js, "}");
+}
+
+// Write the header, official header and vector fields shared by every response
+static void jsonHeader(FILE *js, const char *format, const uint8_t *header, const RomLayout *rom, const uint8_t *official, const uint16_t *vec){
+	fprintf(js, "{\"ok\":true,\"format\":\"%s\"", format);
+	fprintf(js, ",\"mapper\":%d,\"submapper\":%d", rom->mapper, rom->isNes2 ? header[8]>>4 : 0);
+	fprintf(js, ",\"prg_kib\":%ld,\"chr_kib\":%ld", rom->prgSize*16, rom->chrSize*8);
+	fprintf(js, ",\"battery\":%s,\"trainer\":%s", (header[6]&0x02) ? "true" : "false", rom->hasTrainer ? "true" : "false");
+	fprintf(
+		js, ",\"mirroring\":\"%s\"",
+		(header[6]&0x08) ? "none" : (header[6]&0x01) ? "vertical" : "horizontal"
+	);
+	int hasOfficial = isOfficialHeader(official);
+	fprintf(js, ",\"official_header\":%s", hasOfficial ? "true" : "false");
+	if(hasOfficial){
+		char title[16] = {0};
+		memcpy(title, &official[15-official[23]], official[23]+1);
+		fprintf(js, ",\"title\":");
+		jsonString(js, title, sizeof(title));
+	}
+	fprintf(js, ",\"vectors\":{\"nmi\":%d,\"reset\":%d,\"irq\":%d}", vec[0], vec[1], vec[2]);
+}
+
+// Answer a header request for an iNES file from local buffers, without the analysis
+//  lock; return 1, leaving fp open, for other containers, which need the converter
+static uint8_t headerOnly(FILE *fp, FILE *js){
+	uint8_t header[16] = {0};
+	uint8_t official[26] = {0};
+	uint16_t vec[3] = {0};
+	RomLayout rom;
+
+	if(fread(header, 16, 1, fp) != 1 || memcmp(header, "NES\x1a", 4)) return 1;
+	decodeINesHeader(header, &rom);
+	long prgEnd = 16+(rom.hasTrainer ? 512 : 0)+16*1024*rom.prgSize;
+	if(!fseek(fp, prgEnd-32, SEEK_SET)) fread(official, 26, 1, fp);
+	if(!fseek(fp, prgEnd-6, SEEK_SET)) fread(vec, 2, 3, fp);
+	fclose(fp);
+
+	jsonHeader(js, rom.isNes2 ? "NES 2.0" : romFormatNames[FMT_INES], header, &rom, official, vec);
+	fprintf(js, "}");
+	return 0;
+}
+
+// Analyze the ROM in fp and write the JSON response; fp is closed
+static void analyzeRom(FILE *fp, int full, FILE *js){
+	if(fp == NULL){
+		jsonError(js, "can't open ROM");
+		return;
+	}
+	if(!full && !headerOnly(fp, js)) return;
+
+	pthread_mutex_lock(&analysisLock);
+	resetAnalysis();
+	FILE *rom = openRomImage(fp);
+	if(rom == NULL){
+		pthread_mutex_unlock(&analysisLock);
+		fclose(fp);
+		jsonError(js, "not an NES ROM, UNIF, FDS or NSF image");
+		return;
+	}
+	fp = rom;
+	readINesHeader(fp);
+	readOfficialHeader(fp);
+	readHwVectors(fp);
+
+	RomLayout layout = {prgSize, chrSize, mapper, hasTrainer, isNes2};
+	jsonHeader(js, romFormat == FMT_INES && isNes2 ? "NES 2.0" : romFormatNames[romFormat], iNesHeader, &layout, officialHeader, vectors);
+
+	if(full){
+		buildCodeMap(fp);
+		if(!countEmptySpace(fp)){
+			fprintf(js, ",\"free_prg\":[");
+			for(int i=0;i<prgSize;i++) fprintf(js, "%s%d", i ? "," : "", emptySpacePrg[i]);
+			fprintf(js, "],\"free_chr_tiles\":[");
+			for(int i=0;i<chrSize*2;i++) fprintf(js, "%s%d", i ? "," : "", 256-uniqueTileCounter[i]);
+			fprintf(js, "]");
+		}
+		if(prgRom){
+			SigList list = {js, 0};
+			fprintf(js, ",\"signatures\":[");
+			scanSignatures(prgRom, prgSize*16*1024, jsonSignature, &list);
+			fprintf(js, "]");
+		}
+	}
+	fprintf(js, "}");
+
+	resetAnalysis();
+	closeRom(fp);
+	pthread_mutex_unlock(&analysisLock);
+}
+
+static void handleRequest(char *line, FILE *in, FILE *out){
+	char *resp = NULL;
+	size_t respLen = 0;
+	FILE *js = open_memstream(&resp, &respLen);
+	if(!js) return;
+
+	line[strcspn(line, "\r\n")] = 0;
+	if(!strncmp(line, "header ", 7)){
+		analyzeRom(fopen(line+7, "rb"), 0, js);
+	} else if(!strncmp(line, "analyze ", 8)){
+		analyzeRom(fopen(line+8, "rb"), 1, js);
+	} else if(!strncmp(line, "bytes ", 6)){
+		long n = atol(line+6);
+		uint8_t *buf = (n > 0 && n <= MAX_REQUEST_BYTES) ? malloc(n) : NULL;
+		if(!buf || fread(buf, n, 1, in) != 1) jsonError(js, "bad byte count");
+		else analyzeRom(fmemopen(buf, n, "rb"), 1, js);
+		free(buf);
+	} else{
+		jsonError(js, "unknown request");
+	}
+
+	fclose(js);
+	fwrite(resp, respLen, 1, out);
+	fputc('\n', out);
+	fflush(out);
+	free(resp);
+}
+
+static void serveConnection(int fd){
+	char *line = NULL;
+	size_t cap = 0;
+	FILE *in = fdopen(dup(fd), "rb");
+	FILE *out = fdopen(fd, "wb");
+	if(!in || !out){
+		if(in) fclose(in);
+		if(out) fclose(out);
+		else close(fd);
+		return;
+	}
+
+	if(getline(&line, &cap, in) > 0) handleRequest(line, in, out);
+
+	free(line);
+	fclose(in);
+	fclose(out);
+}
+
+static void *serverWorker(void *arg){
+	(void)arg;
+	for(;;){
+		pthread_mutex_lock(&queueLock);
+		while(!readyCount) pthread_cond_wait(&queueReady, &queueLock);
+		int fd = readyFds[readyHead];
+		readyHead = (readyHead+1) % MAX_CONNECTIONS;
+		readyCount--;
+		pthread_mutex_unlock(&queueLock);
+		serveConnection(fd);
+	}
+	return NULL;
+}
+
+// Queue a connection for the workers; return 1 if the queue is full
+static uint8_t queueConnection(int fd){
+	pthread_mutex_lock(&queueLock);
+	uint8_t full = readyCount == MAX_CONNECTIONS;
+	if(!full){
+		readyFds[(readyHead+readyCount) % MAX_CONNECTIONS] = fd;
+		readyCount++;
+		pthread_cond_signal(&queueReady);
+	}
+	pthread_mutex_unlock(&queueLock);
+	return full;
+}
+
+// Accept connections and wait for their request line to arrive; never returns
+static void pollConnections(){
+	static struct pollfd fds[MAX_CONNECTIONS+1];
+	int count = 1;
+
+	fds[0] = (struct pollfd){listenFd, POLLIN, 0};
+	for(;;){
+		if(poll(fds, count, -1) < 0) continue;
+		for(int i=count-1;i>0;i--){
+			if(!fds[i].revents) continue;
+			int fd = fds[i].fd;
+			fds[i] = fds[--count];
+
+			// A client that sends half a line can only stall its worker this long
+			struct timeval timeout = {REQUEST_TIMEOUT, 0};
+			setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+			if(queueConnection(fd)) close(fd);
+		}
+		if(fds[0].revents){
+			int fd = accept(listenFd, NULL, NULL);
+			if(fd >= 0 && count == MAX_CONNECTIONS+1) close(fd);
+			else if(fd >= 0) fds[count++] = (struct pollfd){fd, POLLIN, 0};
+		}
+	}
+}
+
+static int connectSocket(const char *socketPath, struct sockaddr_un *addr){
+	memset(addr, 0, sizeof(*addr));
+	addr->sun_family = AF_UNIX;
+	if(strlen(socketPath) >= sizeof(addr->sun_path)){
+		fprintf(stderr, "Socket path too long.\n");
+		return -1;
+	}
+	strcpy(addr->sun_path, socketPath);
+	return socket(AF_UNIX, SOCK_STREAM, 0);
+}
+
+// Listen on socketPath forever; return only on setup errors
+int serveRequests(const char *socketPath, const char *sigdbPath){
+	struct sockaddr_un addr;
+	pthread_t thread;
+
+	// Everything that can be loaded once is loaded up front
+	if(addBuiltinSignatures() || (sigdbPath && loadSignatureFile(sigdbPath)) || compileSignatures()){
+		fprintf(stderr, "Couldn't load signatures.\n");
+		return 1;
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+	listenFd = connectSocket(socketPath, &addr);
+	if(listenFd < 0) return 1;
+	// Replace a stale socket from a previous run, but never anything else
+	struct stat st;
+	if(!lstat(socketPath, &st)){
+		if(!S_ISSOCK(st.st_mode)){
+			fprintf(stderr, "%s exists and isn't a socket.\n", socketPath);
+			return 1;
+		}
+		unlink(socketPath);
+	}
+	if(bind(listenFd, (struct sockaddr *)&addr, sizeof(addr)) || listen(listenFd, 64)){
+		perror("Error opening socket");
+		return 1;
+	}
+
+	int n = 0;
+	for(int i=0;i<workerCount();i++){
+		if(pthread_create(&thread, NULL, serverWorker, NULL)){
+			fprintf(stderr, "Couldn't start more than %d workers.\n", n);
+			if(!n) return 1;
+			break;
+		}
+		pthread_detach(thread);
+		n++;
+	}
+	printf("Serving on %s with %d workers (%d signatures)\n", socketPath, n, signatureCount);
+	fflush(stdout);
+	pollConnections();
+	return 0;
+}
+
+// Send one request line to a running server and print the response
+int queryServer(const char *socketPath, const char *request){
+	struct sockaddr_un addr;
+	char *line = NULL;
+	size_t cap = 0;
+
+	int fd = connectSocket(socketPath, &addr);
+	if(fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr))){
+		perror("Error connecting to server");
+		return 1;
+	}
+	FILE *io = fdopen(fd, "r+");
+	if(!io) return 1;
+	fprintf(io, "%s\n", request);
+	fflush(io);
+	if(getline(&line, &cap, io) > 0) fputs(line, stdout);
+	free(line);
+	fclose(io);
+	return 0;
+}
@@ -0,0 +1,13 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_SERVER_H
+#define FC_SERVER_H
+
+int serveRequests(const char *socketPath, const char *sigdbPath);
+int queryServer(const char *socketPath, const char *request);
+
+#endif
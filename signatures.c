@@ -0,0 +1,284 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "signatures.h"
+
+// Masked byte signatures are matched with an Aho-Corasick automaton built over the
+//  longest solid (wildcard-free) run of each one; the full pattern is then checked
+//  at every hit. The scan is a single table lookup per byte however many signatures
+//  are loaded.
+
+#define MAX_ANCHOR 8 // Longer anchors don't make hits rarer, only the automaton bigger
+
+// Built-in signatures: common library and init idioms, and the register-level idioms
+//  that sound drivers and decompressors are built from. These find the routines, not
+//  which engine they belong to: fingerprints of a particular engine depend on its build
+//  options and belong in a --sigdb file made from verified dumps
+static const char *const builtinSignatures[][2] = {
+	{"nesdev wiki init code",          "78 D8 A2 40 8E 17 40 A2 FF 9A E8 8E 00 20 8E 01 20 8E 10 40"},
+	{"Controller strobe (LDA #0)",     "A9 01 8D 16 40 A9 00 8D 16 40"},
+	{"Controller strobe (LSR A)",      "A9 01 8D 16 40 4A 8D 16 40"},
+	{"Controller strobe (STX/STY)",    "A2 01 8E 16 40 CA 8E 16 40"},
+	{"Controller read loop",           "AD 16 40 4A ?? ?? CA D0"},
+	{"Vblank wait (BIT/BPL)",          "2C 02 20 10 FB"},
+	{"Vblank wait (LDA/BPL)",          "AD 02 20 10 FB"},
+	{"OAM DMA",                        "A9 ?? 8D 14 40"},
+	{"APU frame IRQ disable",          "A9 40 8D 17 40"},
+	{"MMC1 serial register write",     "8D ?? ?? 4A 8D ?? ?? 4A 8D ?? ?? 4A 8D ?? ?? 4A 8D ?? ??"},
+	{"MMC3 bank select/data pair",     "8D 00 80 ?? ?? 8D 01 80"},
+	{"Jump table via RTS",             "0A A8 B9 ?? ?? 48 B9 ?? ?? 48 60"},
+	{"Sound init: APU register clear", "A2 ?? 9D 00 40 CA 10 FA"},
+	{"Sound init: enable channels",    "A9 0F 8D 15 40"},
+	{"Sound init: pulse sweep off",    "A9 08 8D 01 40 8D 05 40"},
+	{"Sound driver: note period (Y)",  "B9 ?? ?? 8D 02 40 B9 ?? ?? 8D 03 40"},
+	{"Sound driver: note period (X)",  "BD ?? ?? 8D 02 40 BD ?? ?? 8D 03 40"},
+	{"Decompressor: byte fetch",       "A0 00 B1 ?? E6 ?? D0 02 E6"},
+	{"Decompressor: window copy",      "B1 ?? 91 ?? C8 C4 ?? D0 F7"},
+	{"RLE to PPU, tag byte (neslib)",  "B1 ?? 85 ?? C8 D0 02 E6 ?? B1 ?? C8 D0 02 E6 ?? C5 ?? F0 ?? 8D 07 20"},
+};
+
+Signature *signatures;
+int signatureCount;
+static int signatureCap;
+
+// Automaton state
+static uint32_t (*acNext)[256]; // Full DFA transition table
+static int32_t  *acOut;         // First signature ending in each state, or -1
+static int32_t  *acOutNext;     // Next signature with the same anchor end, per signature
+static int32_t  *acDict;        // Nearest suffix state with outputs, or -1
+static int       acStates;
+
+// Parse "A9 ?? 8D 14 40" into a signature
+uint8_t addSignature(const char *name, const char *pattern){
+	if(signatureCount == signatureCap){
+		int cap = signatureCap ? signatureCap*2 : 64;
+		Signature *s = realloc(signatures, cap*sizeof(Signature));
+		if(!s) return 1;
+		signatures = s;
+		signatureCap = cap;
+	}
+
+	Signature *sig = &signatures[signatureCount];
+	memset(sig, 0, sizeof(Signature));
+	snprintf(sig->name, sizeof(sig->name), "%s", name);
+
+	const char *p = pattern;
+	while(*p){
+		while(isspace((unsigned char)*p)) p++;
+		if(!*p) break;
+		if(sig->len == SIG_MAX_LEN) return 1;
+		if(p[0] == '?' && p[1] == '?'){
+			sig->mask[sig->len++] = 0;
+			p += 2;
+			continue;
+		}
+		char *end;
+		char hex[3] = {p[0], p[1], 0};
+		long v = strtol(hex, &end, 16);
+		if(end != hex+2) return 1;
+		sig->bytes[sig->len] = v;
+		sig->mask[sig->len++] = 0xff;
+		p += 2;
+	}
+
+	// Longest solid run becomes the anchor
+	for(int i=0;i<sig->len;){
+		if(!sig->mask[i]){
+			i++;
+			continue;
+		}
+		int j = i;
+		while(j < sig->len && sig->mask[j]) j++;
+		if(j-i > sig->anchorLen){
+			sig->anchor = i;
+			sig->anchorLen = j-i;
+		}
+		i = j;
+	}
+	if(sig->anchorLen < 2) return 1;
+	if(sig->anchorLen > MAX_ANCHOR) sig->anchorLen = MAX_ANCHOR;
+
+	signatureCount++;
+	return 0;
+}
+
+// Load signatures from a file of "name = hex pattern" lines; '#' starts a comment
+uint8_t loadSignatureFile(const char *path){
+	char line[512];
+	int lineNum = 0;
+
+	FILE *fp = fopen(path, "r");
+	if(fp == NULL){
+		perror("Error opening signature file");
+		return 1;
+	}
+	while(fgets(line, sizeof(line), fp)){
+		lineNum++;
+		char *hash = strchr(line, '#');
+		if(hash) *hash = 0;
+
+		char *eq = strchr(line, '=');
+		if(!eq){
+			for(char *c = line; *c; c++){
+				if(!isspace((unsigned char)*c)){
+					fprintf(stderr, "%s:%d: expected 'name = pattern'\n", path, lineNum);
+					break;
+				}
+			}
+			continue;
+		}
+
+		*eq = 0;
+		char *name = line;
+		while(isspace((unsigned char)*name)) name++;
+		for(char *e = eq-1; e >= name && isspace((unsigned char)*e); e--) *e = 0;
+
+		if(addSignature(name, eq+1))
+			fprintf(stderr, "%s:%d: invalid pattern\n", path, lineNum);
+	}
+	fclose(fp);
+	return 0;
+}
+
+uint8_t addBuiltinSignatures(){
+	for(size_t i=0;i<sizeof(builtinSignatures)/sizeof(builtinSignatures[0]);i++){
+		if(addSignature(builtinSignatures[i][0], builtinSignatures[i][1])) return 1;
+	}
+	return 0;
+}
+
+// Build the automaton; call after all signatures have been added
+uint8_t compileSignatures(){
+	int maxStates = 1;
+	for(int i=0;i<signatureCount;i++) maxStates += signatures[i].anchorLen;
+
+	free(acNext);
+	free(acOut);
+	free(acOutNext);
+	free(acDict);
+	acNext = calloc(maxStates, sizeof(*acNext));
+	acOut = malloc(maxStates*sizeof(int32_t));
+	acDict = malloc(maxStates*sizeof(int32_t));
+	acOutNext = malloc((signatureCount+1)*sizeof(int32_t));
+	int32_t *fail = malloc(maxStates*sizeof(int32_t));
+	int32_t *queue = malloc(maxStates*sizeof(int32_t));
+	if(!acNext || !acOut || !acDict || !acOutNext || !fail || !queue){
+		free(fail);
+		free(queue);
+		return 1;
+	}
+
+	// Trie of anchors; 0 in acNext means "no edge" until the failure pass fills it
+	acStates = 1;
+	for(int i=0;i<maxStates;i++) acOut[i] = -1;
+	for(int i=0;i<signatureCount;i++){
+		const Signature *sig = &signatures[i];
+		uint32_t s = 0;
+		for(int k=0;k<sig->anchorLen;k++){
+			uint8_t b = sig->bytes[sig->anchor+k];
+			if(!acNext[s][b]) acNext[s][b] = acStates++;
+			s = acNext[s][b];
+		}
+		acOutNext[i] = acOut[s];
+		acOut[s] = i;
+	}
+
+	// Breadth-first failure links, turning the trie into a DFA
+	int head = 0, tail = 0;
+	fail[0] = 0;
+	acDict[0] = -1;
+	for(int b=0;b<256;b++){
+		uint32_t t = acNext[0][b];
+		if(t){
+			fail[t] = 0;
+			acDict[t] = -1;
+			queue[tail++] = t;
+		}
+	}
+	while(head < tail){
+		uint32_t s = queue[head++];
+		for(int b=0;b<256;b++){
+			uint32_t t = acNext[s][b];
+			if(!t){
+				acNext[s][b] = acNext[fail[s]][b];
+				continue;
+			}
+			fail[t] = acNext[fail[s]][b];
+			acDict[t] = acOut[fail[t]] >= 0 ? fail[t] : acDict[fail[t]];
+			queue[tail++] = t;
+		}
+	}
+
+	free(fail);
+	free(queue);
+	return 0;
+}
+
+static void reportState(int32_t state, const uint8_t *data, size_t len, size_t pos, sigMatchFn fn, void *ctx){
+	for(int32_t i = acOut[state]; i >= 0; i = acOutNext[i]){
+		const Signature *sig = &signatures[i];
+		long start = (long)pos - (sig->anchor + sig->anchorLen - 1);
+		if(start < 0 || start + sig->len > (long)len) continue;
+
+		int ok = 1;
+		for(int k=0;k<sig->len && ok;k++){
+			if((data[start+k] ^ sig->bytes[k]) & sig->mask[k]) ok = 0;
+		}
+		if(ok) fn(sig, start, ctx);
+	}
+}
+
+// Call fn for every signature occurrence in data
+void scanSignatures(const uint8_t *data, size_t len, sigMatchFn fn, void *ctx){
+	uint32_t s = 0;
+	for(size_t i=0;i<len;i++){
+		s = acNext[s][data[i]];
+		if(acOut[s] < 0 && acDict[s] < 0) continue;
+
+		for(int32_t d = acOut[s] >= 0 ? (int32_t)s : acDict[s]; d >= 0; d = acDict[d])
+			reportState(d, data, len, i, fn, ctx);
+	}
+}
+
+static void printMatch(const Signature *sig, uint32_t offset, void *ctx){
+	int *count = ctx;
+	int32_t cpu = cpuAddress(offset);
+	printf(" %s: PRG-ROM bank %u 0x%06x", sig->name, offset/(16*1024), offset);
+	if(cpu >= 0) printf(" (CPU 0x%04x)", cpu);
+	printf("\n");
+	(*count)++;
+}
+
+// Scan PRG-ROM with the built-in signatures plus any already loaded from a file
+int printSignatureMatches(FILE *rom){
+	int count = 0;
+	if(addBuiltinSignatures() || compileSignatures() || loadPrgRom(rom)) return -1;
+
+	printf("Signature matches (%d signatures):\n", signatureCount);
+	scanSignatures(prgRom, prgSize*16*1024, printMatch, &count);
+	if(!count) printf(" None\n");
+	printf("\n");
+	return count;
+}
+
+void freeSignatures(){
+	free(signatures);
+	free(acNext);
+	free(acOut);
+	free(acOutNext);
+	free(acDict);
+	signatures = NULL;
+	acNext = NULL;
+	acOut = acOutNext = acDict = NULL;
+	signatureCount = signatureCap = acStates = 0;
+}
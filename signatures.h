@@ -0,0 +1,36 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_SIGNATURES_H
+#define FC_SIGNATURES_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define SIG_MAX_LEN 64
+
+typedef struct{
+	char    name[64];
+	int     len;
+	uint8_t bytes[SIG_MAX_LEN];
+	uint8_t mask[SIG_MAX_LEN]; // 0xff where the byte must match, 0 for wildcards
+	int     anchor, anchorLen;  // Solid run fed to the automaton
+} Signature;
+
+typedef void (*sigMatchFn)(const Signature *sig, uint32_t offset, void *ctx);
+
+extern Signature *signatures;
+extern int signatureCount;
+
+uint8_t addSignature(const char *name, const char *pattern);
+uint8_t addBuiltinSignatures();
+uint8_t loadSignatureFile(const char *path);
+uint8_t compileSignatures();
+void scanSignatures(const uint8_t *data, size_t len, sigMatchFn fn, void *ctx);
+int printSignatureMatches(FILE *rom);
+void freeSignatures();
+
+#endif
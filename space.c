@@ -0,0 +1,254 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "codemap.h"
+#include "parallel.h"
+#include "space.h"
+
+#define TILECMP(x, y) (!memcmp((x), (y), 16))
+
+#define LZ_HASH_BITS 12
+#define LZ_MAX_MATCH 258
+
+int profileLevel;
+ByteProfile *prgProfile;
+ByteProfile *prgWindowProfile;
+
+// Return the longest run of 0x00 or 0xff bytes in a 16 KiB PRG-ROM bank
+// prgBase is the bank's offset in PRG-ROM, used to skip bytes the code map classified
+int prgBankFreeSpace(const uint8_t *bank, uint32_t prgBase){
+	int cnt00 = 0; // Current run of 0x00 bytes
+	int cntFF = 0; // Current run of 0xff bytes
+	int best = 0;
+	for(int j=0; j<PRG_BANK_SIZE; j++){
+		uint8_t ch = bank[j];
+		// Bytes known to be code or data never count as free
+		int used = codeMap && cmGet(prgBase + j) != CM_UNKNOWN;
+		if (!ch && !used){
+			cnt00++;
+		} else if(ch == 0xff && !used){
+			cntFF++;
+		}else{
+			if     (cnt00 > best) best = cnt00;
+			else if(cntFF > best) best = cntFF;
+			cnt00 = cntFF = 0;
+		}
+	}
+	if     (cnt00 > best) best = cnt00;
+	else if(cntFF > best) best = cntFF;
+	return best;
+}
+
+// Return the number of distinct tiles in a 4 KiB CHR-ROM page
+int chrPageUniqueTiles(const uint8_t *page){
+	const uint8_t *unique[256];
+	int count = 0;
+	for(int j=0;j<256;j++){
+		const uint8_t *tile = &page[j*16];
+		int uniqueTileFlag = 1;
+		for(int k=0;k<count;k++){
+			if(TILECMP(tile, unique[k])){
+				uniqueTileFlag = 0;
+				break;
+			}
+		}
+		if(uniqueTileFlag) unique[count++] = tile;
+	}
+	return count;
+}
+
+// Greedy LZ77 pass with a single-entry hash of 3-byte sequences
+// Output is costed as 1 byte per literal, 2 per match and 1 flag bit per token
+static int lzEstimate(const uint8_t *data, int len){
+	uint16_t table[1<<LZ_HASH_BITS] = {0}; // Last position + 1 of each hash
+	int size = 0, tokens = 0;
+
+	for(int i=0;i<len;tokens++){
+		if(i+3 <= len){
+			uint32_t key = data[i] | data[i+1]<<8 | data[i+2]<<16;
+			uint32_t h = (key * 2654435761u) >> (32-LZ_HASH_BITS);
+			int cand = table[h] - 1;
+			table[h] = i + 1;
+			if(cand >= 0 && !memcmp(data+cand, data+i, 3)){
+				int m = 3;
+				while(i+m < len && m < LZ_MAX_MATCH && data[cand+m] == data[i+m]) m++;
+				size += 2;
+				i += m;
+				continue;
+			}
+		}
+		size++;
+		i++;
+	}
+	return size + (tokens+7)/8;
+}
+
+// Byte histogram, entropy and LZ estimate of a block of at most 64 KiB
+void profileBytes(const uint8_t *data, int len, ByteProfile *out){
+	// Four interleaved histograms keep consecutive increments independent,
+	//  which lets the compiler unroll and pipeline the counting loop
+	uint32_t hist[4][256] = {{0}};
+	int i = 0;
+	for(; i+4<=len; i+=4){
+		hist[0][data[i]]++;
+		hist[1][data[i+1]]++;
+		hist[2][data[i+2]]++;
+		hist[3][data[i+3]]++;
+	}
+	for(; i<len; i++) hist[0][data[i]]++;
+
+	double entropy = 0;
+	memset(out, 0, sizeof(ByteProfile));
+	for(int b=0;b<256;b++){
+		uint32_t c = hist[0][b] + hist[1][b] + hist[2][b] + hist[3][b];
+		if(!c) continue;
+		double p = (double)c / len;
+		entropy -= p * log2(p);
+		out->distinct++;
+		if((int)c > out->topCount){
+			out->topCount = c;
+			out->topByte = b;
+		}
+	}
+	out->entropy = entropy;
+	out->lzSize = lzEstimate(data, len);
+}
+
+typedef struct{
+	const uint8_t *prg;
+	const uint8_t *chr;
+} SpaceJob;
+
+static void prgBankJob(int i, void *ctx){
+	SpaceJob *job = ctx;
+	const uint8_t *bank = job->prg + i*PRG_BANK_SIZE;
+	emptySpacePrg[i] = prgBankFreeSpace(bank, i*PRG_BANK_SIZE);
+
+	// Profile while the bank is still in cache
+	if(profileLevel >= 1) profileBytes(bank, PRG_BANK_SIZE, &prgProfile[i]);
+	if(profileLevel >= 2){
+		const int windows = PRG_BANK_SIZE/PROFILE_WINDOW;
+		for(int w=0;w<windows;w++)
+			profileBytes(bank + w*PROFILE_WINDOW, PROFILE_WINDOW, &prgWindowProfile[i*windows + w]);
+	}
+}
+
+static void chrPageJob(int i, void *ctx){
+	SpaceJob *job = ctx;
+	uniqueTileCounter[i] = chrPageUniqueTiles(job->chr + i*CHR_PAGE_SIZE);
+}
+
+uint8_t countEmptySpace(FILE *rom){
+	SpaceJob job;
+
+	emptySpacePrg = malloc(prgSize*sizeof(int));
+	uniqueTileCounter = malloc(2*chrSize*sizeof(int));
+	if(!emptySpacePrg || !uniqueTileCounter) return 1;
+	if(profileLevel >= 1 && !(prgProfile = malloc(prgSize*sizeof(ByteProfile) + 1))) return 1;
+	if(profileLevel >= 2 && !(prgWindowProfile = malloc(prgSize*PRG_BANK_SIZE/PROFILE_WINDOW*sizeof(ByteProfile) + 1))) return 1;
+	if(prgSize && loadPrgRom(rom)) return 1;
+
+	uint8_t *chr = malloc(chrSize*2*CHR_PAGE_SIZE + 1);
+	if(!chr) return 1;
+	fseek(rom, 16+hasTrainer*512+16*1024*prgSize, SEEK_SET);
+	if(chrSize && !fread(chr, chrSize*2*CHR_PAGE_SIZE, 1, rom)){
+		free(chr);
+		return 1;
+	}
+	job.prg = prgRom;
+	job.chr = chr;
+
+	// Banks are independent and each one writes its own result slot,
+	//  so large ROMs are simply split across threads
+	parallelFor(prgSize, PARALLEL_MIN_BANKS, prgBankJob, &job);
+	parallelFor(chrSize*2, PARALLEL_MIN_BANKS, chrPageJob, &job);
+
+	free(chr);
+	return 0;
+}
+
+// Two-sided 95% Student t quantiles for 1-29 degrees of freedom; 1.96 beyond
+static const double tQuantiles[] = {
+	12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+	2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+	2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045
+};
+
+// Deterministic, so repeated runs sample the same banks
+static uint32_t sampleSeed = 0x2a6d365b;
+
+static uint32_t nextRandom(){
+	sampleSeed ^= sampleSeed<<13;
+	sampleSeed ^= sampleSeed>>17;
+	sampleSeed ^= sampleSeed<<5;
+	return sampleSeed;
+}
+
+// Sample units (PRG-ROM banks or CHR-ROM pages) stratified by position: the units are
+//  split into equal runs and one is read at random from each, so every part of the ROM
+//  is represented. The interval uses the simple random sampling variance, which is
+//  conservative for a stratified sample.
+static uint8_t sampleUnits(
+	FILE *rom, long base, int units, int unitLen, double fraction,
+	int (*measure)(const uint8_t *unit, uint32_t offset), SpaceEstimate *out
+){
+	memset(out, 0, sizeof(SpaceEstimate));
+	out->units = units;
+	if(!units) return 0;
+
+	int n = ceil(fraction*units);
+	if(n < 2) n = units < 2 ? units : 2;
+	if(n > units) n = units;
+
+	uint8_t *buf = malloc(unitLen);
+	if(!buf) return 1;
+
+	double sum = 0, sumSq = 0;
+	for(int k=0;k<n;k++){
+		int first = (int64_t)k*units/n, end = (int64_t)(k+1)*units/n;
+		int i = first + nextRandom()%(end-first);
+		fseek(rom, base + (long)i*unitLen, SEEK_SET);
+		if(fread(buf, unitLen, 1, rom) != 1){
+			free(buf);
+			return 1;
+		}
+		int v = measure(buf, i*unitLen);
+		if(!k || v < out->min) out->min = v;
+		if(!k || v > out->max) out->max = v;
+		sum += v;
+		sumSq += (double)v*v;
+	}
+	free(buf);
+
+	out->sampled = n;
+	out->mean = sum/n;
+	out->total = out->mean*units;
+	if(n < 2) return 0; // The only unit, read in full
+	double var = (sumSq - sum*out->mean)/(n-1);
+	double t = n-1 <= 29 ? tQuantiles[n-2] : 1.96;
+	out->margin = t*units*sqrt((var > 0 ? var : 0)/n*(1 - (double)n/units));
+	return 0;
+}
+
+static int chrPageRedundantTiles(const uint8_t *page, uint32_t offset){
+	(void)offset;
+	return 256 - chrPageUniqueTiles(page);
+}
+
+// Estimate the free space countEmptySpace() would find from a fraction of the PRG-ROM
+//  banks and CHR-ROM pages, reading only those
+uint8_t estimateEmptySpace(FILE *rom, double fraction, SpaceEstimate *prg, SpaceEstimate *chr){
+	long base = 16 + hasTrainer*512;
+	if(sampleUnits(rom, base, prgSize, PRG_BANK_SIZE, fraction, prgBankFreeSpace, prg)) return 1;
+	return sampleUnits(rom, base + prgSize*PRG_BANK_SIZE, chrSize*2, CHR_PAGE_SIZE, fraction, chrPageRedundantTiles, chr);
+}
@@ -0,0 +1,52 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_SPACE_H
+#define FC_SPACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define PRG_BANK_SIZE (16*1024)
+#define CHR_PAGE_SIZE (4*1024)
+
+// Don't bother with threads for less than this many banks per worker
+#define PARALLEL_MIN_BANKS 16
+
+#define PROFILE_WINDOW 1024
+
+typedef struct{
+	float   entropy;  // Shannon entropy in bits per byte
+	int     distinct; // Distinct byte values
+	uint8_t topByte;  // Most common byte value
+	int     topCount;
+	int     lzSize;   // Estimated size after LZ compression
+} ByteProfile;
+
+// Default fraction of banks and pages read by estimateEmptySpace()
+#define SAMPLE_FRACTION 0.1
+
+typedef struct{
+	int    units;    // PRG-ROM banks or CHR-ROM pages in the ROM
+	int    sampled;
+	int    min, max; // Over the sampled units
+	double mean;     // Per sampled unit
+	double total;    // Estimated over all units
+	double margin;   // Half-width of the 95% confidence interval of total
+} SpaceEstimate;
+
+// 0: no profile, 1: per bank, 2: per bank and per PROFILE_WINDOW
+extern int profileLevel;
+extern ByteProfile *prgProfile;
+extern ByteProfile *prgWindowProfile;
+
+int prgBankFreeSpace(const uint8_t *bank, uint32_t prgBase);
+int chrPageUniqueTiles(const uint8_t *page);
+void profileBytes(const uint8_t *data, int len, ByteProfile *out);
+uint8_t countEmptySpace(FILE *rom);
+uint8_t estimateEmptySpace(FILE *rom, double fraction, SpaceEstimate *prg, SpaceEstimate *chr);
+
+#endif
@@ -0,0 +1,404 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#define _XOPEN_SOURCE 500 // nftw()
+
+#include <ftw.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "filter.h"
+#include "parallel.h"
+#include "space.h"
+#include "summary.h"
+#include "watch.h"
+
+// Collection summary: every file is read and measured once by whichever worker claims
+//  it, and its counts go to that worker's partial aggregate, so workers never share
+//  a counter; the partials are merged once at the end. Only what medians and duplicate
+//  detection need is kept per file.
+
+// Power-of-two size classes: 0 KiB, 1 KiB, 2 KiB... 2^(SIZE_CLASSES-2) KiB and up
+#define SIZE_CLASSES 24
+
+enum _summary_anomalies{
+	ANOM_SHORT,
+	ANOM_EXTRA,
+	ANOM_LEFTOVER,
+	ANOM_PRG_SIZE,
+	ANOM_NO_PRG,
+	ANOM_COUNT
+};
+
+static const char *const anomalyNames[] = {
+	"File shorter than the header says",
+	"Data past the end of CHR-ROM",
+	"Leftover text in bytes 7-15",
+	"PRG-ROM size not a power of two",
+	"No PRG-ROM"
+};
+
+enum _summary_formats{
+	SUM_UNIF,
+	SUM_FDS,
+	SUM_NSF,
+	SUM_OTHER,
+	SUM_UNREADABLE,
+	SUM_FORMATS
+};
+
+typedef struct{
+	long     roms, nes2, official, trainer;
+	long     files[SUM_FORMATS]; // Files that aren't iNES ROMs
+	long     mappers[4096];
+	long     prgSizes[SIZE_CLASSES];
+	long     chrSizes[SIZE_CLASSES];
+	long     anomalies[ANOM_COUNT];
+	long     filtered[STAGE_COUNT]; // Files --where dropped at each stage
+	uint64_t freePrg, freeChr;
+} Aggregate;
+
+typedef struct{
+	uint64_t hash;    // Of PRG-ROM and CHR-ROM
+	int64_t  freePrg; // Bytes, -1 if the file wasn't measured
+	int64_t  freeChr; // Tiles
+} RomResult;
+
+typedef struct{
+	Aggregate *partials; // One per worker
+	RomResult *results;  // One per file
+} SummaryJob;
+
+static char **paths;
+static int pathCount, pathCap;
+
+static FilterProgram whereProgram;
+static const char *whereExpr; // NULL if every file is summarized
+
+static int collectPath(const char *path, const struct stat *st, int type, struct FTW *ftw){
+	(void)st;
+	(void)ftw;
+	if(type != FTW_F) return 0;
+	if(pathCount == pathCap){
+		pathCap = pathCap ? pathCap*2 : 1024;
+		char **grown = realloc(paths, pathCap*sizeof(char *));
+		if(!grown) return 1;
+		paths = grown;
+	}
+	if(!(paths[pathCount] = strdup(path))) return 1;
+	pathCount++;
+	return 0;
+}
+
+static int sizeClass(int64_t kib){
+	int c = 0;
+	while(kib && c < SIZE_CLASSES-1){
+		kib >>= 1;
+		c++;
+	}
+	return c;
+}
+
+// Count the file as dropped if the --where predicates of this stage don't hold
+static int rejected(Aggregate *agg, filterStage stage, const int64_t *values){
+	if(!whereExpr || runFilter(&whereProgram, stage, values)) return 0;
+	agg->filtered[stage]++;
+	return 1;
+}
+
+static void summarizeRom(int worker, int i, void *ctx){
+	SummaryJob *job = ctx;
+	Aggregate *agg = &job->partials[worker];
+	RomResult *res = &job->results[i];
+	int64_t values[FIELD_COUNT] = {0};
+	uint8_t header[16];
+	long size = 0;
+
+	res->freePrg = res->freeChr = -1;
+	FILE *fp = fopen(paths[i], "rb");
+	if(fp == NULL){
+		agg->files[SUM_UNREADABLE]++;
+		return;
+	}
+	setvbuf(fp, NULL, _IONBF, 0); // Read only what each stage asks for
+	fseek(fp, 0, SEEK_END);
+	size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	if(size >= 16 && fread(header, 16, 1, fp) != 1){
+		agg->files[SUM_UNREADABLE]++;
+		fclose(fp);
+		return;
+	}
+	if(size < 16 || memcmp(header, "NES\x1a", 4)){
+		// --where fields only exist for iNES ROMs
+		if(whereExpr) agg->filtered[STAGE_HEADER]++;
+		else if(size < 16) agg->files[SUM_OTHER]++;
+		else if(!memcmp(header, "UNIF", 4)) agg->files[SUM_UNIF]++;
+		else if(!memcmp(header, "FDS\x1a", 4) || !memcmp(header, "\x01*NINTENDO-HVC*", 15)) agg->files[SUM_FDS]++;
+		else if(!memcmp(header, "NESM\x1a", 5)) agg->files[SUM_NSF]++;
+		else agg->files[SUM_OTHER]++;
+		fclose(fp);
+		return;
+	}
+
+	// Same decoding and checks as the single-ROM analyses, on this file's own copy
+	RomLayout rom;
+	decodeINesHeader(header, &rom);
+	uint64_t prgBase = 16 + (rom.hasTrainer ? 512 : 0);
+	uint64_t prgLen = rom.prgSize*PRG_BANK_SIZE;
+	uint64_t chrLen = rom.chrSize*2*CHR_PAGE_SIZE;
+	int complete = (uint64_t)size >= prgBase + prgLen + chrLen;
+
+	// Predicates run as soon as their fields are known: header-only ones drop the
+	//  file before any PRG/CHR-ROM is read, and only survivors are measured
+	filterHeaderValues(header, size, values);
+	if(rejected(agg, STAGE_HEADER, values)){
+		fclose(fp);
+		return;
+	}
+	// Predicates of later stages may use this field too, so fill it whenever filtering
+	if(whereExpr){
+		uint8_t official[26];
+		values[FIELD_OFFICIAL] =
+			prgLen && (uint64_t)size >= prgBase + prgLen &&
+			!fseek(fp, prgBase + prgLen-32, SEEK_SET) && fread(official, 26, 1, fp) == 1 &&
+			isOfficialHeader(official);
+		if(rejected(agg, STAGE_OFFICIAL, values)){
+			fclose(fp);
+			return;
+		}
+	}
+
+	uint8_t *data = malloc(size);
+	fseek(fp, 0, SEEK_SET);
+	if(data && fread(data, size, 1, fp) != 1){
+		free(data);
+		data = NULL;
+	}
+	fclose(fp);
+	if(!data){
+		agg->files[SUM_UNREADABLE]++;
+		return;
+	}
+
+	const uint8_t *prg = data + prgBase;
+	const uint8_t *chr = prg + prgLen;
+	int64_t freePrg = 0, freeChr = 0;
+	if(complete){
+		// Same kernels as -s, but with no code map (it's process-wide state and files are
+		//  measured in parallel), so bytes -s would classify as code or data can count
+		//  as free here; the report says so
+		for(int b=0;b<rom.prgSize;b++) freePrg += prgBankFreeSpace(prg + b*PRG_BANK_SIZE, b*PRG_BANK_SIZE);
+		for(int p=0;p<rom.chrSize*2;p++) freeChr += 256 - chrPageUniqueTiles(chr + p*CHR_PAGE_SIZE);
+	}
+	if(whereExpr && whereProgram.len[STAGE_ANALYSIS]){
+		values[FIELD_FREE_PRG] = freePrg;
+		values[FIELD_FREE_CHR] = freeChr;
+		// A truncated file can't be measured, so it can't match
+		if(!complete) agg->filtered[STAGE_ANALYSIS]++;
+		if(!complete || rejected(agg, STAGE_ANALYSIS, values)){
+			free(data);
+			return;
+		}
+	}
+
+	agg->roms++;
+	agg->nes2 += rom.isNes2;
+	agg->trainer += !!rom.hasTrainer;
+	agg->mappers[rom.mapper]++;
+	agg->prgSizes[sizeClass(rom.prgSize*16)]++;
+	agg->chrSizes[sizeClass(rom.chrSize*8)]++;
+	if(!rom.isNes2 && (data[7]&0x0c) == 0x04) agg->anomalies[ANOM_LEFTOVER]++;
+	if(rom.prgSize & (rom.prgSize-1)) agg->anomalies[ANOM_PRG_SIZE]++;
+	if(!rom.prgSize) agg->anomalies[ANOM_NO_PRG]++;
+	if(!complete){
+		agg->anomalies[ANOM_SHORT]++;
+		free(data);
+		return;
+	}
+	if((uint64_t)size > prgBase + prgLen + chrLen && !(rom.isNes2 && data[14])) agg->anomalies[ANOM_EXTRA]++;
+	if(prgLen && isOfficialHeader(prg + prgLen-32)) agg->official++;
+
+	res->freePrg = freePrg;
+	res->freeChr = freeChr;
+	agg->freePrg += freePrg;
+	agg->freeChr += freeChr;
+	res->hash = hashBlock(prg, prgLen + chrLen);
+	free(data);
+}
+
+static int compareInt64(const void *a, const void *b){
+	int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+	return (x > y) - (x < y);
+}
+
+static int compareUint64(const void *a, const void *b){
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+	return (x > y) - (x < y);
+}
+
+static const long *sortedMapperCounts;
+
+// Most common mappers first
+static int compareMappers(const void *a, const void *b){
+	long x = sortedMapperCounts[*(const int *)a], y = sortedMapperCounts[*(const int *)b];
+	return (x < y) - (x > y);
+}
+
+static double percent(long n, long total){
+	return total ? 100.0*n/total : 0;
+}
+
+static void printSizes(const long *sizes, long roms){
+	for(int c=0;c<SIZE_CLASSES;c++){
+		if(!sizes[c]) continue;
+		printf(" %ld KiB%s: %ld (%.1f%%)\n", c ? 1L<<(c-1) : 0, c == SIZE_CLASSES-1 ? " and up" : "", sizes[c], percent(sizes[c], roms));
+	}
+	printf("\n");
+}
+
+// Return the median of the measured values (>= 0) in v, sorting v
+static int64_t median(int64_t *v, int n){
+	qsort(v, n, sizeof(int64_t), compareInt64);
+	int first = 0;
+	while(first < n && v[first] < 0) first++;
+	return first < n ? v[first + (n-first)/2] : 0;
+}
+
+static void printSummary(const char *dir, const Aggregate *total, RomResult *results){
+	long files = total->roms;
+	for(int f=0;f<SUM_FORMATS;f++) files += total->files[f];
+	for(int s=0;s<STAGE_COUNT;s++) files += total->filtered[s];
+
+	printf("Collection summary of %s:\n", dir);
+	printf(
+		" Files: %ld (%ld iNES/NES 2.0, %ld UNIF, %ld FDS, %ld NSF, %ld other, %ld unreadable)\n",
+		files, total->roms, total->files[SUM_UNIF], total->files[SUM_FDS], total->files[SUM_NSF],
+		total->files[SUM_OTHER], total->files[SUM_UNREADABLE]
+	);
+	if(whereExpr){
+		printf(" Matching %s\n", whereExpr);
+		printf("  Dropped from the header alone: %ld\n", total->filtered[STAGE_HEADER]);
+		printf("  Dropped after reading the official header: %ld\n", total->filtered[STAGE_OFFICIAL]);
+		printf("  Dropped after free space analysis: %ld\n", total->filtered[STAGE_ANALYSIS]);
+	}
+	printf(" NES 2.0 headers: %ld (%.1f%%)\n", total->nes2, percent(total->nes2, total->roms));
+	printf(" Official headers: %ld (%.1f%%)\n", total->official, percent(total->official, total->roms));
+	printf(" Trainers: %ld\n", total->trainer);
+
+	// Duplicates: identical PRG-ROM and CHR-ROM, whatever the header says
+	uint64_t *hashes = malloc((pathCount+1)*sizeof(uint64_t));
+	int64_t *values = malloc((pathCount+1)*sizeof(int64_t));
+	if(hashes && values){
+		int n = 0;
+		for(int i=0;i<pathCount;i++) if(results[i].freePrg >= 0) hashes[n++] = results[i].hash;
+		qsort(hashes, n, sizeof(uint64_t), compareUint64);
+		long copies = 0, groups = 0;
+		for(int i=1;i<n;i++){
+			if(hashes[i] != hashes[i-1]) continue;
+			copies++;
+			if(i == 1 || hashes[i-1] != hashes[i-2]) groups++;
+		}
+		printf(" Duplicates: %ld extra copies of %ld ROMs\n\n", copies, groups);
+	}
+
+	int mapperOrder[4096], used = 0;
+	for(int m=0;m<4096;m++) if(total->mappers[m]) mapperOrder[used++] = m;
+	sortedMapperCounts = total->mappers;
+	qsort(mapperOrder, used, sizeof(int), compareMappers);
+	printf("Mappers:\n");
+	for(int i=0;i<used;i++){
+		int m = mapperOrder[i];
+		printf(" %d: %ld (%.1f%%)\n", m, total->mappers[m], percent(total->mappers[m], total->roms));
+	}
+	printf("\n");
+
+	printf("PRG-ROM sizes (rounded down to a power of two):\n");
+	printSizes(total->prgSizes, total->roms);
+	printf("CHR-ROM sizes (rounded down to a power of two):\n");
+	printSizes(total->chrSizes, total->roms);
+
+	if(hashes && values){
+		printf("Free space (filler runs only, complete ROMs only):\n");
+		for(int i=0;i<pathCount;i++) values[i] = results[i].freePrg;
+		printf(" PRG-ROM: %llu bytes total, %lld bytes median\n", (unsigned long long)total->freePrg, (long long)median(values, pathCount));
+		for(int i=0;i<pathCount;i++) values[i] = results[i].freeChr;
+		printf(" CHR-ROM: %llu tiles total, %lld tiles median\n\n", (unsigned long long)total->freeChr, (long long)median(values, pathCount));
+	} else{
+		printf("Free space and duplicate analysis failed: memory error.\n\n");
+	}
+	free(hashes);
+	free(values);
+
+	printf("Header anomalies:\n");
+	for(int a=0;a<ANOM_COUNT;a++) printf(" %s: %ld\n", anomalyNames[a], total->anomalies[a]);
+	printf("\n");
+}
+
+static void freePaths(){
+	for(int i=0;i<pathCount;i++) free(paths[i]);
+	free(paths);
+	paths = NULL;
+	pathCount = pathCap = 0;
+}
+
+// Walk dir recursively and print aggregate statistics of every ROM in it, or of those
+//  matching the --where expression where (NULL for all)
+int summarizeCollection(const char *dir, const char *where){
+	SummaryJob job;
+	int workers = workerCount();
+
+	if(where && compileFilter(where, &whereProgram)) return 1;
+	whereExpr = where;
+
+	if(nftw(dir, collectPath, 64, FTW_PHYS)){
+		perror("Error reading directory");
+		freePaths();
+		return 1;
+	}
+
+	job.partials = calloc(workers, sizeof(Aggregate));
+	job.results = malloc((pathCount+1)*sizeof(RomResult));
+	if(!job.partials || !job.results){
+		printf("Collection summary failed: memory error.\n");
+		free(job.partials);
+		free(job.results);
+		freePaths();
+		return 1;
+	}
+
+	// Files are handed out one at a time: their sizes vary too much for fixed chunks
+	parallelForWorkers(pathCount, 1, summarizeRom, &job);
+
+	// Merge the partials into the first one
+	Aggregate *total = &job.partials[0];
+	for(int w=1;w<workers;w++){
+		Aggregate *part = &job.partials[w];
+		total->roms += part->roms;
+		total->nes2 += part->nes2;
+		total->official += part->official;
+		total->trainer += part->trainer;
+		total->freePrg += part->freePrg;
+		total->freeChr += part->freeChr;
+		for(int f=0;f<SUM_FORMATS;f++) total->files[f] += part->files[f];
+		for(int m=0;m<4096;m++) total->mappers[m] += part->mappers[m];
+		for(int c=0;c<SIZE_CLASSES;c++){
+			total->prgSizes[c] += part->prgSizes[c];
+			total->chrSizes[c] += part->chrSizes[c];
+		}
+		for(int a=0;a<ANOM_COUNT;a++) total->anomalies[a] += part->anomalies[a];
+		for(int s=0;s<STAGE_COUNT;s++) total->filtered[s] += part->filtered[s];
+	}
+	printSummary(dir, total, job.results);
+
+	free(job.partials);
+	free(job.results);
+	freePaths();
+	return 0;
+}
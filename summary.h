@@ -0,0 +1,12 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_SUMMARY_H
+#define FC_SUMMARY_H
+
+int summarizeCollection(const char *dir, const char *where);
+
+#endif
@@ -0,0 +1,311 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <libgen.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "base.h"
+#include "cdl.h"
+#include "codemap.h"
+#include "parallel.h"
+#include "space.h"
+#include "watch.h"
+
+// Per-bank state of one build of the ROM
+typedef struct{
+	int64_t  prgSize, chrSize;
+	int      hasTrainer;
+	uint64_t *prgHash, *chrHash;
+	uint64_t *mapHash; // Code map slice of each PRG bank
+	int      *prgFree, *chrUnique;
+	uint16_t vectors[3];
+	struct stat cdl;     // Code/data log the map was built with; st_ino is 0 if none
+	int      retraced;   // The code map was traced again for this build
+} Snapshot;
+
+// 64-bit FNV-1a over 8-byte words; len must be a multiple of 8
+uint64_t hashBlock(const uint8_t *data, size_t len){
+	uint64_t h = 0xcbf29ce484222325;
+	for(size_t i=0;i<len;i+=8){
+		uint64_t w;
+		memcpy(&w, data+i, 8);
+		h = (h ^ w) * 0x100000001b3;
+		h ^= h>>32;
+	}
+	return h;
+}
+
+static void freeSnapshot(Snapshot *s){
+	free(s->prgHash);
+	free(s->chrHash);
+	free(s->mapHash);
+	free(s->prgFree);
+	free(s->chrUnique);
+	memset(s, 0, sizeof(Snapshot));
+}
+
+// Read the ROM and decode its header into the globals; return the file contents or NULL
+static uint8_t *loadRom(const char *romPath, size_t *len){
+	FILE *fp = fopen(romPath, "rb");
+	if(fp == NULL) return NULL;
+	fseek(fp, 0, SEEK_END);
+	*len = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+
+	uint8_t *data = malloc(*len ? *len : 1);
+	if(data && (*len < 16 || fread(data, *len, 1, fp) != 1 || memcmp(data, "NES\x1a", 4))){
+		free(data);
+		data = NULL;
+	}
+	if(data){
+		fseek(fp, 0, SEEK_SET);
+		readINesHeader(fp);
+	}
+	fclose(fp);
+
+	if(data && *len < (size_t)(16 + hasTrainer*512 + prgSize*PRG_BANK_SIZE + chrSize*2*CHR_PAGE_SIZE)){
+		free(data);
+		data = NULL;
+	}
+	return data;
+}
+
+typedef struct{
+	Snapshot       *cur;
+	const Snapshot *prev; // NULL if the layout changed
+	const uint8_t  *prg, *chr;
+	int            changed;
+} WatchJob;
+
+static void prgHashJob(int i, void *ctx){
+	WatchJob *job = ctx;
+	job->cur->prgHash[i] = hashBlock(job->prg + i*PRG_BANK_SIZE, PRG_BANK_SIZE);
+}
+
+static void prgBankJob(int i, void *ctx){
+	WatchJob *job = ctx;
+	job->cur->mapHash[i] = codeMap ? hashBlock(codeMap + i*PRG_BANK_SIZE/4, PRG_BANK_SIZE/4) : 0;
+	if(
+		job->prev && job->cur->prgHash[i] == job->prev->prgHash[i] &&
+		job->cur->mapHash[i] == job->prev->mapHash[i]
+	){
+		job->cur->prgFree[i] = job->prev->prgFree[i];
+		return;
+	}
+	job->cur->prgFree[i] = prgBankFreeSpace(job->prg + i*PRG_BANK_SIZE, i*PRG_BANK_SIZE);
+	__atomic_fetch_add(&job->changed, 1, __ATOMIC_RELAXED);
+}
+
+static void chrPageJob(int i, void *ctx){
+	WatchJob *job = ctx;
+	job->cur->chrHash[i] = hashBlock(job->chr + i*CHR_PAGE_SIZE, CHR_PAGE_SIZE);
+	if(job->prev && job->cur->chrHash[i] == job->prev->chrHash[i]){
+		job->cur->chrUnique[i] = job->prev->chrUnique[i];
+		return;
+	}
+	job->cur->chrUnique[i] = chrPageUniqueTiles(job->chr + i*CHR_PAGE_SIZE);
+	__atomic_fetch_add(&job->changed, 1, __ATOMIC_RELAXED);
+}
+
+static int sameCdl(const struct stat *a, const struct stat *b){
+	return
+		a->st_dev == b->st_dev && a->st_ino == b->st_ino && a->st_size == b->st_size &&
+		a->st_mtim.tv_sec == b->st_mtim.tv_sec && a->st_mtim.tv_nsec == b->st_mtim.tv_nsec;
+}
+
+// Bring the code map up to date with this build, so free space is measured the same
+//  way as -s. The trace only reads the fixed-bank view, so while those banks and the
+//  code/data log are unchanged the previous map is kept and only the changed banks
+//  are reclassified; otherwise the whole map is traced again
+static void mapCode(Snapshot *cur, const Snapshot *prev, const char *romPath, const uint8_t *data, size_t len){
+	const uint8_t *prg = data + 16 + hasTrainer*512;
+
+	unloadCdl();
+	memset(&cur->cdl, 0, sizeof(cur->cdl));
+	if(!loadCdl(romPath)) stat(cdlPath, &cur->cdl);
+
+	int reuse = prev && codeMap && prgRom && sameCdl(&cur->cdl, &prev->cdl);
+	for(int i=0;reuse && i<prgSize;i++){
+		if(cpuAddress(i*PRG_BANK_SIZE) >= 0 && cur->prgHash[i] != prev->prgHash[i]) reuse = 0;
+	}
+	if(reuse){
+		for(int i=0;i<prgSize;i++){
+			if(cur->prgHash[i] == prev->prgHash[i]) continue;
+			memcpy(prgRom + i*PRG_BANK_SIZE, prg + i*PRG_BANK_SIZE, PRG_BANK_SIZE);
+			remapBank(i);
+		}
+		return;
+	}
+
+	free(prgRom);
+	free(codeMap);
+	prgRom = codeMap = NULL;
+	cur->retraced = 1;
+	FILE *fp = fmemopen((void *)data, len, "rb");
+	if(fp == NULL) return;
+	readHwVectors(fp);
+	buildCodeMap(fp);
+	fclose(fp);
+}
+
+// Hash every bank and its code map and re-run the space analysis only where either
+//  differs from prev; a change in the fixed banks can reclassify code in another
+// Return the number of banks that were re-analyzed
+static int analyze(Snapshot *cur, const Snapshot *prev, const char *romPath, const uint8_t *data, size_t len){
+	int sameLayout = prev && prev->prgSize == prgSize && prev->chrSize == chrSize && prev->hasTrainer == hasTrainer;
+	const uint8_t *prg = data + 16 + hasTrainer*512;
+	const uint8_t *chr = prg + prgSize*PRG_BANK_SIZE;
+	int changed;
+
+	cur->prgSize = prgSize;
+	cur->chrSize = chrSize;
+	cur->hasTrainer = hasTrainer;
+	cur->prgHash = malloc(prgSize*sizeof(uint64_t));
+	cur->prgFree = malloc(prgSize*sizeof(int));
+	cur->mapHash = malloc(prgSize*sizeof(uint64_t));
+	cur->chrHash = malloc(2*chrSize*sizeof(uint64_t));
+	cur->chrUnique = malloc(2*chrSize*sizeof(int));
+	if(!cur->prgHash || !cur->prgFree || !cur->mapHash || !cur->chrHash || !cur->chrUnique) return -1;
+
+	WatchJob job = {cur, sameLayout ? prev : NULL, prg, chr, 0};
+	parallelFor(prgSize, PARALLEL_MIN_BANKS, prgHashJob, &job);
+	mapCode(cur, job.prev, romPath, data, len);
+	parallelFor(prgSize, PARALLEL_MIN_BANKS, prgBankJob, &job);
+	parallelFor(chrSize*2, PARALLEL_MIN_BANKS, chrPageJob, &job);
+	changed = job.changed;
+
+	// Vectors live at the end of the last bank; only re-read them if it changed
+	if(sameLayout && prgSize && cur->prgHash[prgSize-1] == prev->prgHash[prgSize-1]){
+		memcpy(cur->vectors, prev->vectors, sizeof(cur->vectors));
+	} else if(prgSize){
+		const uint8_t *v = prg + prgSize*PRG_BANK_SIZE - 6;
+		for(int i=0;i<3;i++) cur->vectors[i] = v[i*2] | v[i*2+1]<<8;
+	}
+	return changed;
+}
+
+static void printDiff(const Snapshot *cur, const Snapshot *prev){
+	const char *vecNames[] = {"Vblank NMI", "Entry point", "External IRQ"};
+
+	if(prev->prgSize != cur->prgSize || prev->chrSize != cur->chrSize){
+		printf(
+			" Layout changed: PRG %ld -> %ld KiB, CHR %ld -> %ld KiB\n",
+			prev->prgSize*16, cur->prgSize*16, prev->chrSize*8, cur->chrSize*8
+		);
+		return;
+	}
+	for(int i=0;i<cur->prgSize;i++){
+		if(cur->prgFree[i] != prev->prgFree[i])
+			printf(" PRG-ROM bank %d: %d -> %d bytes\n", i, prev->prgFree[i], cur->prgFree[i]);
+	}
+	for(int i=0;i<cur->chrSize*2;i++){
+		if(cur->chrUnique[i] != prev->chrUnique[i])
+			printf(" CHR-ROM page %d: %d -> %d tiles\n", i, 256-prev->chrUnique[i], 256-cur->chrUnique[i]);
+	}
+	for(int i=0;i<3;i++){
+		if(cur->vectors[i] != prev->vectors[i])
+			printf(" %s: 0x%04x -> 0x%04x\n", vecNames[i], prev->vectors[i], cur->vectors[i]);
+	}
+}
+
+static void printSnapshot(const Snapshot *s){
+	for(int i=0;i<s->prgSize;i++)
+		printf(" Free space in PRG-ROM bank %d: %d bytes\n", i, s->prgFree[i]);
+	for(int i=0;i<s->chrSize*2;i++)
+		printf(" Free space in CHR-ROM page %d: %d tiles\n", i, 256-s->chrUnique[i]);
+}
+
+// Keep re-analyzing the ROM whenever it is rewritten; only returns on error
+int watchRom(const char *romPath){
+	Snapshot prev = {0}, cur = {0};
+	size_t len;
+	char dirBuf[4096], baseBuf[4096];
+	char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+	snprintf(dirBuf, sizeof(dirBuf), "%s", romPath);
+	snprintf(baseBuf, sizeof(baseBuf), "%s", romPath);
+	const char *dir = dirname(dirBuf);
+	const char *base = basename(baseBuf);
+
+	// Watch the directory: build tools often replace the file instead of rewriting it
+	int fd = inotify_init();
+	if(fd < 0 || inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0){
+		perror("Error watching ROM");
+		return 1;
+	}
+
+	uint8_t *data = loadRom(romPath, &len);
+	if(!data || analyze(&prev, NULL, romPath, data, len) < 0){
+		fprintf(stderr, "Couldn't analyze %s.\n", romPath);
+		free(data);
+		return 1;
+	}
+	free(data);
+	printf("Watching %s\n", romPath);
+	printSnapshot(&prev);
+	printf("\n");
+	fflush(stdout);
+
+	for(int build=1;;){
+		ssize_t n = read(fd, events, sizeof(events));
+		if(n <= 0){
+			perror("Error watching ROM");
+			break;
+		}
+
+		int touched = 0;
+		for(char *p = events; p < events + n;){
+			struct inotify_event *ev = (struct inotify_event *)p;
+			if(ev->len && !strcmp(ev->name, base)) touched = 1;
+			p += sizeof(struct inotify_event) + ev->len;
+		}
+		if(!touched) continue;
+
+		struct timespec t0, t1;
+		data = loadRom(romPath, &len);
+		if(!data){
+			printf("Build %d: not a complete NES ROM, skipped\n\n", build++);
+			fflush(stdout);
+			continue;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		int changed = analyze(&cur, &prev, romPath, data, len);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		free(data);
+		if(changed < 0){
+			fprintf(stderr, "Out of memory.\n");
+			break;
+		}
+
+		long us = (t1.tv_sec - t0.tv_sec)*1000000 + (t1.tv_nsec - t0.tv_nsec)/1000;
+		printf(
+			"Build %d: %d of %ld banks re-analyzed%s in %ld us\n",
+			build++, changed, cur.prgSize + cur.chrSize*2, cur.retraced ? ", code map re-traced" : "", us
+		);
+		printDiff(&cur, &prev);
+		printf("\n");
+		fflush(stdout);
+
+		freeSnapshot(&prev);
+		prev = cur;
+		memset(&cur, 0, sizeof(Snapshot));
+	}
+
+	freeSnapshot(&prev);
+	free(prgRom);
+	free(codeMap);
+	prgRom = codeMap = NULL;
+	unloadCdl();
+	close(fd);
+	return 1;
+}
@@ -0,0 +1,15 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_WATCH_H
+#define FC_WATCH_H
+
+#include <stdint.h>
+
+uint64_t hashBlock(const uint8_t *data, size_t len);
+int watchRom(const char *romPath);
+
+#endif
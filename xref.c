@@ -0,0 +1,269 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "base.h"
+#include "cdl.h"
+#include "codemap.h"
+#include "instructions.h"
+#include "names.h"
+#include "xref.h"
+
+Xref *xrefs;
+int xrefCount;
+
+static const char *const kindNames[] = {
+	"call",
+	"jump",
+	"branch",
+	"read",
+	"write"
+};
+
+static uint8_t accessKind(uint8_t instr){
+	switch(instr){
+		case INS_STA:
+		case INS_STX:
+		case INS_STY:
+		case INS_INC:
+		case INS_DEC:
+		case INS_ASL:
+		case INS_LSR:
+		case INS_ROL:
+		case INS_ROR:
+		return XREF_WRITE;
+
+		default:
+		return XREF_READ;
+	}
+}
+
+static int compareXrefs(const void *a, const void *b){
+	const Xref *x = a, *y = b;
+	if(x->targetOffset != y->targetOffset) return (x->targetOffset > y->targetOffset) - (x->targetOffset < y->targetOffset);
+	if(x->target != y->target) return x->target - y->target;
+	return (x->sourceOffset > y->sourceOffset) - (x->sourceOffset < y->sourceOffset);
+}
+
+// CPU address of a PRG-ROM offset: the fixed-bank view if it's visible there, else the
+//  window a code/data log saw it in, else the bank's offset from $8000
+static uint16_t bankAddress(uint32_t offset){
+	int32_t addr = cpuAddress(offset);
+	if(addr >= 0) return addr;
+	return cdlPrg ? cdlAddress(offset) : 0x8000 | (offset & 0x3fff);
+}
+
+// PRG-ROM offset of a target referenced from code at offset (mapped at addr): targets
+//  in the same window as switchable-bank code are in that bank, the rest are looked up
+//  in the fixed-bank view
+static int32_t targetOffset(uint32_t offset, uint16_t addr, uint16_t target){
+	uint32_t end = prgSize*16*1024;
+	int32_t result = -1;
+	if(target < 0x8000) return -1;
+	if(cpuAddress(offset) >= 0) return prgOffset(target);
+
+	if((target ^ addr) < 0x2000 && (addr & 0x1fff) == (offset & 0x1fff))
+		result = (offset & ~0x1fff) | (target & 0x1fff);
+	else if((target ^ addr) < 0x4000 && (addr & 0x3fff) == (offset & 0x3fff))
+		result = (offset & ~0x3fff) | (target & 0x3fff);
+	else
+		return prgOffset(target);
+	return (uint32_t)result < end ? result : -1;
+}
+
+// Record an edge for every operand of every instruction marked as code in the code map,
+//  in every PRG-ROM bank
+// Expects buildCodeMap() to have been called
+uint8_t buildXrefs(){
+	uint32_t end = prgSize*16*1024;
+	if(!codeMap) return 1;
+	if(xrefs) return 0;
+
+	// At most one edge per instruction, and instructions take at least one byte
+	xrefs = malloc((end+1)*sizeof(Xref));
+	if(!xrefs) return 1;
+
+	for(uint32_t offset=0; offset<end; offset++){
+		if(cmGet(offset) != CM_CODE) continue;
+
+		Opcode op = opcodes[prgRom[offset]];
+		uint8_t len = instruction_length[op.addr_mode];
+		uint16_t addr = bankAddress(offset);
+		uint8_t  param8 = offset+1 < end ? prgRom[offset+1] : 0;
+		uint16_t param16 = param8 | (offset+2 < end ? prgRom[offset+2] : 0)<<8;
+		Xref *x = &xrefs[xrefCount];
+		x->source = addr;
+		x->sourceOffset = offset;
+
+		switch(op.addr_mode){
+			case AM_IMPLIED:
+			case AM_ACCUMULATOR:
+			case AM_IMMEDIATE:
+			continue;
+
+			case AM_RELATIVE:
+			x->target = relative_addr(addr+len, (int8_t)param8);
+			x->kind = XREF_BRANCH;
+			break;
+
+			case AM_ABSOLUTE_INDIRECT:
+			// The pointer itself is what gets read
+			x->target = param16;
+			x->kind = XREF_READ;
+			break;
+
+			default:
+			x->target = len == 3 ? param16 : param8;
+			x->kind = (
+				op.instr == INS_JSR ? XREF_CALL :
+				op.instr == INS_JMP ? XREF_JUMP :
+				accessKind(op.instr)
+			);
+		}
+		x->targetOffset = targetOffset(offset, addr, x->target);
+		xrefCount++;
+	}
+
+	qsort(xrefs, xrefCount, sizeof(Xref), compareXrefs);
+	return 0;
+}
+
+// Return the index of the first edge to target (at targetOffset in PRG-ROM, or -1),
+//  or -1 if there is none
+int findXrefs(uint16_t target, int32_t targetOffset){
+	int lo = 0, hi = xrefCount;
+	while(lo < hi){
+		int mid = (lo+hi)/2;
+		const Xref *x = &xrefs[mid];
+		if(x->targetOffset < targetOffset || (x->targetOffset == targetOffset && x->target < target)) lo = mid+1;
+		else hi = mid;
+	}
+	return (lo < xrefCount && xrefs[lo].target == target && xrefs[lo].targetOffset == targetOffset) ? lo : -1;
+}
+
+// Name an address the same way the disassembly does, with hardware registers spelled out
+// offset is the PRG-ROM offset of ROM addresses, -1 otherwise; code and data outside the
+//  fixed-bank view are named with their bank
+void xrefLabel(uint16_t addr, int32_t offset, char *out, size_t n){
+	const char *vecNames[] = {"nmi", "reset", "irq"};
+	int fixed = offset < 0 || cpuAddress(offset) == addr;
+	for(int i=0;i<3;i++){
+		if(vectors[i] == addr && fixed){
+			snprintf(out, n, "%s", vecNames[i]);
+			return;
+		}
+	}
+
+	if(addr >= 0x2000 && addr < 0x2008)
+		snprintf(out, n, "%s", ppuRegisterNames[addr&7]);
+	else if(addr >= 0x2008 && addr < 0x4000)
+		// Mirrors get their own symbol, or the .inc would define the register twice
+		snprintf(out, n, "%s_%04X", ppuRegisterNames[addr&7], addr);
+	else if(addr >= 0x4000 && addr < 0x4018)
+		snprintf(out, n, "%s", apuRegisterNames[addr-0x4000]);
+	else if(addr < 0x100)
+		snprintf(out, n, "zp_%02X", addr);
+	else if(addr < 0x800)
+		snprintf(out, n, "ram_%04X", addr);
+	else if(addr < 0x2000 && (addr&0x7ff) < 0x100)
+		// RAM mirrors are unique per address too, for the same reason as the PPU's
+		snprintf(out, n, "zp_%02X_%04X", addr&0xff, addr);
+	else if(addr < 0x2000)
+		snprintf(out, n, "ram_%04X", addr);
+	else if(addr >= 0x4018 && addr < 0x6000)
+		snprintf(out, n, "exp_%04X", addr); // Cartridge expansion area
+	else if(addr < 0x8000)
+		snprintf(out, n, "sram_%04X", addr);
+	else{
+		char kind = offset >= 0 && codeMap && cmGet(offset) == CM_CODE ? 'L' : 'D';
+		if(fixed) snprintf(out, n, "%c%04X", kind, addr);
+		else snprintf(out, n, "%c%X_%04X", kind, offset/(16*1024), addr);
+	}
+}
+
+void printXrefs(){
+	char label[16], source[16];
+
+	printf("Cross references:\n");
+	for(int i=0;i<xrefCount;){
+		uint16_t target = xrefs[i].target;
+		int32_t offset = xrefs[i].targetOffset;
+		xrefLabel(target, offset, label, sizeof(label));
+		printf(" $%04X %s:\n", target, label);
+		for(; i<xrefCount && xrefs[i].target == target && xrefs[i].targetOffset == offset; i++){
+			xrefLabel(xrefs[i].source, xrefs[i].sourceOffset, source, sizeof(source));
+			printf("  %-6s from %s\n", kindNames[xrefs[i].kind], source);
+		}
+	}
+	printf("\n");
+}
+
+static FILE *openSymbolFile(const char *romPath, const char *suffix){
+	char path[4096];
+	snprintf(path, sizeof(path), "%s%s", romPath, suffix);
+	FILE *fp = fopen(path, "w");
+	if(fp == NULL) perror("Error writing symbol file");
+	else printf(" %s\n", path);
+	return fp;
+}
+
+// Write FCEUX (.nl), Mesen (.mlb) and ca65 (.inc) label files for every referenced address
+uint8_t exportSymbols(const char *romPath){
+	char label[16], suffix[16];
+	FILE *nlBank = NULL;
+	int nlBankNum = -1;
+
+	printf("Symbol files:\n");
+	FILE *mlb = openSymbolFile(romPath, ".mlb");
+	FILE *inc = openSymbolFile(romPath, ".inc");
+	FILE *nlRam = openSymbolFile(romPath, ".ram.nl");
+	if(!mlb || !inc || !nlRam) return 1;
+
+	for(int i=0;i<xrefCount;i++){
+		uint16_t target = xrefs[i].target;
+		int32_t offset = xrefs[i].targetOffset;
+		if(i && xrefs[i-1].target == target && xrefs[i-1].targetOffset == offset) continue;
+		xrefLabel(target, offset, label, sizeof(label));
+
+		fprintf(inc, "%s = $%04X\n", label, target);
+
+		if(target < 0x2000){
+			fprintf(nlRam, "$%04X#%s#\n", target&0x7ff, label);
+			fprintf(mlb, "R:%04X:%s\n", target&0x7ff, label);
+		} else if(target >= 0x6000 && target < 0x8000){
+			fprintf(nlRam, "$%04X#%s#\n", target, label);
+			fprintf(mlb, "S:%04X:%s\n", target&0x1fff, label);
+		} else if(target < 0x6000){
+			fprintf(nlRam, "$%04X#%s#\n", target, label);
+			fprintf(mlb, "G:%04X:%s\n", target, label);
+		} else{
+			if(offset < 0) continue;
+			fprintf(mlb, "P:%04X:%s\n", offset, label);
+
+			// FCEUX keeps one file per 16 KiB PRG bank; edges are sorted by target offset,
+			//  so banks come in order
+			int bank = offset / (16*1024);
+			if(nlBankNum != bank){
+				if(nlBank) fclose(nlBank);
+				snprintf(suffix, sizeof(suffix), ".%X.nl", bank);
+				nlBank = openSymbolFile(romPath, suffix);
+				nlBankNum = bank;
+			}
+			if(nlBank) fprintf(nlBank, "$%04X#%s#\n", target, label);
+		}
+	}
+
+	if(nlBank) fclose(nlBank);
+	fclose(mlb);
+	fclose(inc);
+	fclose(nlRam);
+	printf("\n");
+	return 0;
+}
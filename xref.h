@@ -0,0 +1,39 @@
+/*
+	fcinfo
+	Copyright 2026 TheFallenWarrior
+	Licensed under MIT/Expat
+*/
+
+#ifndef FC_XREF_H
+#define FC_XREF_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+enum _xref_kinds{
+	XREF_CALL,
+	XREF_JUMP,
+	XREF_BRANCH,
+	XREF_READ,
+	XREF_WRITE
+};
+
+typedef struct{
+	uint16_t target;
+	uint16_t source;
+	int32_t  targetOffset; // PRG-ROM offset of the target, -1 outside PRG-ROM
+	uint32_t sourceOffset;
+	uint8_t  kind;
+} Xref;
+
+// Sorted by target offset, then target, then source offset
+extern Xref *xrefs;
+extern int xrefCount;
+
+uint8_t buildXrefs();
+int findXrefs(uint16_t target, int32_t targetOffset);
+void xrefLabel(uint16_t addr, int32_t offset, char *out, size_t n);
+void printXrefs();
+uint8_t exportSymbols(const char *romPath);
+
+#endif